@@ -82,7 +82,18 @@ namespace nk::cl {
             m_own_allocator = false;
         }
 
+        T* begin() { return m_data; }
+        T* end() { return m_data + m_length; }
+        const T* begin() const { return m_data; }
+        const T* end() const { return m_data + m_length; }
+
+        std::span<T> span() { return std::span<T>(m_data, m_length); }
+        std::span<const T> span() const { return std::span<const T>(m_data, m_length); }
+        operator std::span<T>() { return span(); }
+        operator std::span<const T>() const { return span(); }
+
         T* data() { return m_data; }
+        const T* data() const { return m_data; }
         u64 length() const { return m_length; }
         bool empty() const { return m_length == 0; }
         mem::Allocator* allocator() { return m_allocator; }
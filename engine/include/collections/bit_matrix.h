@@ -0,0 +1,262 @@
+#pragma once
+
+#include "memory/allocator.h"
+#include "collections/dyn_bitset.h"
+
+namespace nk::cl {
+    // Row-major matrix of bits for pairwise relations (a depends on b, a
+    // overlaps b). Every row is padded to a multiple of 256 bits so row
+    // operations never need a scalar tail.
+    class bit_matrix {
+    public:
+        static constexpr u64 row_alignment_words = 4;
+
+        bit_matrix()
+            : m_words{nullptr},
+              m_rows{0},
+              m_columns{0},
+              m_row_words{0},
+              m_allocator{nullptr},
+              m_own_allocator{false} {}
+
+        bit_matrix(bit_matrix&& other)
+            : m_words{other.m_words},
+              m_rows{other.m_rows},
+              m_columns{other.m_columns},
+              m_row_words{other.m_row_words},
+              m_allocator{other.m_allocator},
+              m_own_allocator{other.m_own_allocator} {
+            other.m_words = nullptr;
+            other.m_rows = 0;
+            other.m_columns = 0;
+            other.m_row_words = 0;
+            other.m_allocator = nullptr;
+            other.m_own_allocator = false;
+        }
+
+        bit_matrix& operator=(bit_matrix&& other) {
+            m_words = other.m_words;
+            m_rows = other.m_rows;
+            m_columns = other.m_columns;
+            m_row_words = other.m_row_words;
+            m_allocator = other.m_allocator;
+            m_own_allocator = other.m_own_allocator;
+
+            other.m_words = nullptr;
+            other.m_rows = 0;
+            other.m_columns = 0;
+            other.m_row_words = 0;
+            other.m_allocator = nullptr;
+            other.m_own_allocator = false;
+
+            return *this;
+        }
+
+        bit_matrix(const bit_matrix&) = delete;
+        bit_matrix& operator=(const bit_matrix&) = delete;
+
+        ~bit_matrix() {
+            if (m_allocator != nullptr) {
+                _bit_matrix_clear();
+                return;
+            }
+            WarnLogIf(m_words != nullptr, "nk::cl::~bit_matrix not correctly freed.");
+        }
+
+        void _bit_matrix_init(mem::Allocator* allocator, u64 rows, u64 columns) {
+            Assert(allocator != nullptr);
+            m_allocator = allocator;
+            set_shape(rows, columns);
+            if (total_words() > 0)
+                m_words = m_allocator->allocate_lot_t(u64, total_words());
+            reset_all();
+        }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _bit_matrix_init(cstr file, u32 line, mem::Allocator* allocator, u64 rows, u64 columns) {
+            Assert(allocator != nullptr);
+            m_allocator = allocator;
+            set_shape(rows, columns);
+            if (total_words() > 0)
+                m_words = m_allocator->_allocate_lot_t<u64>(file, line, total_words());
+            reset_all();
+        }
+#endif
+
+        void _bit_matrix_init_own(mem::Allocator* allocator, u64 rows, u64 columns) {
+            _bit_matrix_init(allocator, rows, columns);
+            m_own_allocator = true;
+        }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _bit_matrix_init_own(cstr file, u32 line, mem::Allocator* allocator, u64 rows, u64 columns) {
+            _bit_matrix_init(file, line, allocator, rows, columns);
+            m_own_allocator = true;
+        }
+#endif
+
+        void _bit_matrix_clear() {
+            if (m_words == nullptr)
+                return;
+
+            if (m_allocator == nullptr) {
+                ErrorLog("nk::cl::bit_matrix::bit_matrix_clear Trying to clear matrix with no allocator, initialize.");
+                return;
+            }
+
+            m_allocator->free_lot_t(u64, m_words, total_words());
+            m_words = nullptr;
+            set_shape(0, 0);
+        }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _bit_matrix_clear(cstr file, u32 line) {
+            if (m_words == nullptr)
+                return;
+
+            if (m_allocator == nullptr) {
+                ErrorLog("nk::cl::bit_matrix::bit_matrix_clear Trying to clear matrix with no allocator, initialize.");
+                return;
+            }
+
+            m_allocator->_free_lot_t<u64>(file, line, m_words, total_words());
+            m_words = nullptr;
+            set_shape(0, 0);
+        }
+#endif
+
+        void _bit_matrix_shutdown() {
+            _bit_matrix_clear();
+
+            if (m_own_allocator)
+                native_deconstruct(mem::Allocator, m_allocator);
+
+            m_allocator = nullptr;
+            m_own_allocator = false;
+        }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _bit_matrix_shutdown(cstr file, u32 line) {
+            _bit_matrix_clear(file, line);
+
+            if (m_own_allocator)
+                os::_native_deconstruct<mem::Allocator>(file, line, m_allocator);
+
+            m_allocator = nullptr;
+            m_own_allocator = false;
+        }
+#endif
+
+        bool test(const u64 row, const u64 column) const {
+            Assert(row < m_rows && column < m_columns);
+            return (this->row(row)[bits::word_index(column)] & bits::bit_mask(column)) != 0;
+        }
+
+        void set(const u64 row, const u64 column) {
+            Assert(row < m_rows && column < m_columns);
+            this->row(row)[bits::word_index(column)] |= bits::bit_mask(column);
+        }
+
+        void reset(const u64 row, const u64 column) {
+            Assert(row < m_rows && column < m_columns);
+            this->row(row)[bits::word_index(column)] &= ~bits::bit_mask(column);
+        }
+
+        // Sets (a, b) and (b, a), for relations that have no direction.
+        void set_symmetric(const u64 a, const u64 b) {
+            set(a, b);
+            set(b, a);
+        }
+
+        void reset_all() {
+            if (m_words != nullptr)
+                std::memset(m_words, 0, sizeof(u64) * total_words());
+        }
+        void reset_row(const u64 row) { std::memset(this->row(row), 0, sizeof(u64) * m_row_words); }
+
+        // Row destination |= row source.
+        void or_row(const u64 destination, const u64 source) {
+            bits::apply<bits::Op::Or>(row(destination), row(destination), row(source), m_row_words);
+        }
+
+        u64 count_row(const u64 row) const { return bits::popcount(this->row(row), m_row_words); }
+        bool any_in_row(const u64 row) const { return bits::any(this->row(row), m_row_words); }
+
+        template <typename Func>
+        void for_each_in_row(const u64 row, Func&& func) const {
+            bits::for_each_set(this->row(row), m_row_words, std::forward<Func>(func));
+        }
+
+        // ORs into out the rows of every bit set in selection. With a
+        // dependency matrix this turns a dirty set into the set it touches.
+        void or_selected_rows(const dyn_bitset& selection, dyn_bitset& out) const {
+            Assert(selection.length() == m_rows && out.length() == m_columns);
+            selection.for_each_set([&](u64 row) {
+                bits::apply<bits::Op::Or>(out.words(), out.words(), this->row(row), out.word_count());
+            });
+        }
+
+        u64* row(const u64 row) {
+            Assert(row < m_rows);
+            return m_words + row * m_row_words;
+        }
+
+        const u64* row(const u64 row) const {
+            Assert(row < m_rows);
+            return m_words + row * m_row_words;
+        }
+
+        u64 rows() const { return m_rows; }
+        u64 columns() const { return m_columns; }
+        u64 row_words() const { return m_row_words; }
+        mem::Allocator* allocator() { return m_allocator; }
+        bool owns_allocator() const { return m_own_allocator; }
+
+    private:
+        void set_shape(u64 rows, u64 columns) {
+            m_rows = rows;
+            m_columns = columns;
+            const u64 words = bits::word_count(columns);
+            m_row_words = (words + row_alignment_words - 1) / row_alignment_words * row_alignment_words;
+        }
+
+        u64 total_words() const { return m_rows * m_row_words; }
+
+        u64* m_words;
+        u64 m_rows;
+        u64 m_columns;
+        u64 m_row_words;
+        mem::Allocator* m_allocator;
+        bool m_own_allocator;
+    };
+}
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+
+    #define bit_matrix_init(allocator, rows, columns) \
+        _bit_matrix_init(__FILE__, __LINE__, (allocator), (rows), (columns))
+
+    #define bit_matrix_init_own(allocator, rows, columns) \
+        _bit_matrix_init_own(__FILE__, __LINE__, (allocator), (rows), (columns))
+
+    #define bit_matrix_clear() \
+        _bit_matrix_clear(__FILE__, __LINE__)
+
+    #define bit_matrix_shutdown() \
+        _bit_matrix_shutdown(__FILE__, __LINE__)
+
+#else
+
+    #define bit_matrix_init(allocator, rows, columns) \
+        _bit_matrix_init((allocator), (rows), (columns))
+
+    #define bit_matrix_init_own(allocator, rows, columns) \
+        _bit_matrix_init_own((allocator), (rows), (columns))
+
+    #define bit_matrix_clear() \
+        _bit_matrix_clear()
+
+    #define bit_matrix_shutdown() \
+        _bit_matrix_shutdown()
+
+#endif
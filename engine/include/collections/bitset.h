@@ -0,0 +1,275 @@
+#pragma once
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define NK_BITS_AVX2 TRUE
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define NK_BITS_SSE2 TRUE
+#endif
+
+namespace nk::cl {
+    // Word level operations shared by the bitset containers. Bulk operations
+    // process 256 bits per instruction with AVX2 and 128 with SSE2, the tail
+    // and constant evaluation fall back to plain u64 words.
+    namespace bits {
+        static constexpr u64 word_bits = 64;
+
+        constexpr u64 word_count(const u64 bit_count) { return (bit_count + word_bits - 1) / word_bits; }
+        constexpr u64 word_index(const u64 bit) { return bit / word_bits; }
+        constexpr u64 bit_mask(const u64 bit) { return u64{1} << (bit % word_bits); }
+
+        // Mask of the bits used in the last word, all ones when the count fills it.
+        constexpr u64 tail_mask(const u64 bit_count) {
+            const u64 used = bit_count % word_bits;
+            return used == 0 ? ~u64{0} : (u64{1} << used) - 1;
+        }
+
+        enum class Op {
+            And,
+            Or,
+            Xor,
+            AndNot,
+        };
+
+        template <Op O>
+        constexpr u64 apply_word(const u64 a, const u64 b) {
+            if constexpr (O == Op::And) {
+                return a & b;
+            } else if constexpr (O == Op::Or) {
+                return a | b;
+            } else if constexpr (O == Op::Xor) {
+                return a ^ b;
+            } else {
+                return a & ~b;
+            }
+        }
+
+        // dst[i] = a[i] op b[i], dst may alias a or b.
+        template <Op O>
+        constexpr void apply(u64* dst, const u64* a, const u64* b, const u64 count) {
+            u64 i = 0;
+            if (!std::is_constant_evaluated()) {
+#if NK_BITS_AVX2
+                for (; i + 4 <= count; i += 4) {
+                    const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                    const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+                    __m256i result;
+                    if constexpr (O == Op::And) {
+                        result = _mm256_and_si256(va, vb);
+                    } else if constexpr (O == Op::Or) {
+                        result = _mm256_or_si256(va, vb);
+                    } else if constexpr (O == Op::Xor) {
+                        result = _mm256_xor_si256(va, vb);
+                    } else {
+                        result = _mm256_andnot_si256(vb, va);
+                    }
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), result);
+                }
+#elif NK_BITS_SSE2
+                for (; i + 2 <= count; i += 2) {
+                    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+                    const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+                    __m128i result;
+                    if constexpr (O == Op::And) {
+                        result = _mm_and_si128(va, vb);
+                    } else if constexpr (O == Op::Or) {
+                        result = _mm_or_si128(va, vb);
+                    } else if constexpr (O == Op::Xor) {
+                        result = _mm_xor_si128(va, vb);
+                    } else {
+                        result = _mm_andnot_si128(vb, va);
+                    }
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), result);
+                }
+#endif
+            }
+            for (; i < count; i++) {
+                dst[i] = apply_word<O>(a[i], b[i]);
+            }
+        }
+
+        constexpr u64 popcount(const u64* words, const u64 count) {
+            u64 total = 0;
+            for (u64 i = 0; i < count; i++) {
+                total += static_cast<u64>(std::popcount(words[i]));
+            }
+            return total;
+        }
+
+        constexpr bool any(const u64* words, const u64 count) {
+            u64 i = 0;
+            if (!std::is_constant_evaluated()) {
+#if NK_BITS_AVX2
+                for (; i + 4 <= count; i += 4) {
+                    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+                    if (!_mm256_testz_si256(v, v))
+                        return true;
+                }
+#endif
+            }
+            for (; i < count; i++) {
+                if (words[i] != 0)
+                    return true;
+            }
+            return false;
+        }
+
+        // Index of the first set bit at or after from, bit_count if there is none.
+        constexpr u64 find_next(const u64* words, const u64 bit_count, const u64 from) {
+            if (from >= bit_count)
+                return bit_count;
+
+            const u64 count = word_count(bit_count);
+            u64 index = word_index(from);
+            u64 word = words[index] & (~u64{0} << (from % word_bits));
+            while (true) {
+                if (word != 0) {
+                    const u64 bit = index * word_bits + static_cast<u64>(std::countr_zero(word));
+                    return bit < bit_count ? bit : bit_count;
+                }
+                if (++index >= count)
+                    return bit_count;
+                word = words[index];
+            }
+        }
+
+        // Calls func(bit) for every set bit in ascending order.
+        template <typename Func>
+        constexpr void for_each_set(const u64* words, const u64 count, Func&& func) {
+            for (u64 i = 0; i < count; i++) {
+                u64 word = words[i];
+                while (word != 0) {
+                    func(i * word_bits + static_cast<u64>(std::countr_zero(word)));
+                    word &= word - 1;
+                }
+            }
+        }
+    }
+
+    // Fixed size bitset stored inline in u64 words. Bits past N are always zero.
+    template <u64 N>
+        requires(N > 0)
+    class bitset {
+    public:
+        static constexpr u64 bit_count = N;
+        static constexpr u64 word_count = bits::word_count(N);
+
+        constexpr bitset()
+            : m_words{} {}
+
+        constexpr bitset(std::initializer_list<u64> set_bits)
+            : m_words{} {
+            for (u64 bit : set_bits) {
+                set(bit);
+            }
+        }
+
+        constexpr bool operator[](const u64 bit) const { return test(bit); }
+
+        constexpr bool test(const u64 bit) const {
+            Assert(bit < N);
+            return (m_words[bits::word_index(bit)] & bits::bit_mask(bit)) != 0;
+        }
+
+        constexpr void set(const u64 bit) {
+            Assert(bit < N);
+            m_words[bits::word_index(bit)] |= bits::bit_mask(bit);
+        }
+
+        constexpr void set(const u64 bit, const bool value) {
+            if (value) {
+                set(bit);
+            } else {
+                reset(bit);
+            }
+        }
+
+        constexpr void reset(const u64 bit) {
+            Assert(bit < N);
+            m_words[bits::word_index(bit)] &= ~bits::bit_mask(bit);
+        }
+
+        constexpr void flip(const u64 bit) {
+            Assert(bit < N);
+            m_words[bits::word_index(bit)] ^= bits::bit_mask(bit);
+        }
+
+        constexpr void set_all() {
+            for (u64 i = 0; i < word_count; i++) {
+                m_words[i] = ~u64{0};
+            }
+            m_words[word_count - 1] &= bits::tail_mask(N);
+        }
+
+        constexpr void reset_all() {
+            for (u64 i = 0; i < word_count; i++) {
+                m_words[i] = 0;
+            }
+        }
+
+        constexpr u64 count() const { return bits::popcount(m_words, word_count); }
+        constexpr bool any() const { return bits::any(m_words, word_count); }
+        constexpr bool none() const { return !any(); }
+        constexpr bool all() const { return count() == N; }
+
+        // Returns N when no bit is set.
+        constexpr u64 find_first() const { return bits::find_next(m_words, N, 0); }
+        constexpr u64 find_next(const u64 from) const { return bits::find_next(m_words, N, from); }
+
+        template <typename Func>
+        constexpr void for_each_set(Func&& func) const {
+            bits::for_each_set(m_words, word_count, std::forward<Func>(func));
+        }
+
+        constexpr bitset& operator&=(const bitset& other) {
+            bits::apply<bits::Op::And>(m_words, m_words, other.m_words, word_count);
+            return *this;
+        }
+
+        constexpr bitset& operator|=(const bitset& other) {
+            bits::apply<bits::Op::Or>(m_words, m_words, other.m_words, word_count);
+            return *this;
+        }
+
+        constexpr bitset& operator^=(const bitset& other) {
+            bits::apply<bits::Op::Xor>(m_words, m_words, other.m_words, word_count);
+            return *this;
+        }
+
+        // Clears every bit that is set in other.
+        constexpr bitset& and_not(const bitset& other) {
+            bits::apply<bits::Op::AndNot>(m_words, m_words, other.m_words, word_count);
+            return *this;
+        }
+
+        constexpr bitset operator&(const bitset& other) const { return bitset(*this) &= other; }
+        constexpr bitset operator|(const bitset& other) const { return bitset(*this) |= other; }
+        constexpr bitset operator^(const bitset& other) const { return bitset(*this) ^= other; }
+
+        constexpr bitset operator~() const {
+            bitset result;
+            for (u64 i = 0; i < word_count; i++) {
+                result.m_words[i] = ~m_words[i];
+            }
+            result.m_words[word_count - 1] &= bits::tail_mask(N);
+            return result;
+        }
+
+        constexpr bool operator==(const bitset& other) const {
+            for (u64 i = 0; i < word_count; i++) {
+                if (m_words[i] != other.m_words[i])
+                    return false;
+            }
+            return true;
+        }
+
+        constexpr u64* words() { return m_words; }
+        constexpr const u64* words() const { return m_words; }
+
+        constexpr u64 length() const { return N; }
+
+    private:
+        alignas(32) u64 m_words[word_count];
+    };
+}
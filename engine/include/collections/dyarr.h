@@ -130,12 +130,48 @@ namespace nk::cl {
         void _dyarr_resize(cstr file, u32 line, u64 length);
 #endif
 
+        void _dyarr_push_range(const T* values, u64 count);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _dyarr_push_range(cstr file, u32 line, const T* values, u64 count);
+#endif
+
+        void _dyarr_insert_range(u64 index, const T* values, u64 count);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _dyarr_insert_range(cstr file, u32 line, u64 index, const T* values, u64 count);
+#endif
+
+        // Grows the array by count elements and returns a pointer to the first new one,
+        // the caller is responsible for writing every new element.
+        T* _dyarr_append_uninitialized(u64 count)
+            requires std::is_trivially_copyable_v<T>;
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        T* _dyarr_append_uninitialized(cstr file, u32 line, u64 count)
+            requires std::is_trivially_copyable_v<T>;
+#endif
+
         void dyarr_reset() { m_length = 0; }
 
         std::optional<T> dyarr_pop();
         std::optional<T> dyarr_remove(u64 index);
+        std::optional<T> dyarr_swap_remove(u64 index);
+
+        // Removes every element matching the predicate in a single compacting pass,
+        // keeping the order of the remaining ones. Returns the removed count.
+        template <typename Predicate>
+        u64 dyarr_erase_if(Predicate predicate);
+
+        T* begin() { return m_data; }
+        T* end() { return m_data + m_length; }
+        const T* begin() const { return m_data; }
+        const T* end() const { return m_data + m_length; }
+
+        std::span<T> span() { return std::span<T>(m_data, m_length); }
+        std::span<const T> span() const { return std::span<const T>(m_data, m_length); }
+        operator std::span<T>() { return span(); }
+        operator std::span<const T>() const { return span(); }
 
         T* data() { return m_data; }
+        const T* data() const { return m_data; }
         u64 length() const { return m_length; }
         u64 capacity() const { return m_capacity; }
         bool empty() const { return m_length == 0; }
@@ -143,6 +179,9 @@ namespace nk::cl {
         bool owns_allocator() const { return m_own_allocator; }
 
     private:
+        void open_gap(u64 index, u64 count);
+        void copy_into(u64 index, const T* values, u64 count);
+
         void grow(u64 capacity);
 #if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
         void grow(cstr file, u32 line, u64 capacity);
@@ -723,6 +762,96 @@ namespace nk::cl {
     }
 #endif
 
+    template <IArrT T>
+    void dyarr<T>::_dyarr_push_range(const T* values, u64 count) {
+        if (count == 0)
+            return;
+
+        if (m_length + count > m_capacity)
+            grow(m_length + count);
+
+        copy_into(m_length, values, count);
+        m_length += count;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT T>
+    void dyarr<T>::_dyarr_push_range(cstr file, u32 line, const T* values, u64 count) {
+        if (count == 0)
+            return;
+
+        if (m_length + count > m_capacity)
+            grow(file, line, m_length + count);
+
+        copy_into(m_length, values, count);
+        m_length += count;
+    }
+#endif
+
+    template <IArrT T>
+    void dyarr<T>::_dyarr_insert_range(u64 index, const T* values, u64 count) {
+        if (count == 0)
+            return;
+
+        if (index > m_length) {
+            WarnLog("nk::cl::dyarr::insert_range Index '{}' out of bounds! Length: {}", index, m_length);
+            return;
+        }
+
+        if (m_length + count > m_capacity)
+            grow(m_length + count);
+
+        open_gap(index, count);
+        copy_into(index, values, count);
+        m_length += count;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT T>
+    void dyarr<T>::_dyarr_insert_range(cstr file, u32 line, u64 index, const T* values, u64 count) {
+        if (count == 0)
+            return;
+
+        if (index > m_length) {
+            WarnLog("nk::cl::dyarr::insert_range Index '{}' out of bounds! Length: {}", index, m_length);
+            return;
+        }
+
+        if (m_length + count > m_capacity)
+            grow(file, line, m_length + count);
+
+        open_gap(index, count);
+        copy_into(index, values, count);
+        m_length += count;
+    }
+#endif
+
+    template <IArrT T>
+    T* dyarr<T>::_dyarr_append_uninitialized(u64 count)
+        requires std::is_trivially_copyable_v<T>
+    {
+        if (m_length + count > m_capacity)
+            grow(m_length + count);
+
+        T* data = m_data + m_length;
+        m_length += count;
+        return data;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT T>
+    T* dyarr<T>::_dyarr_append_uninitialized(cstr file, u32 line, u64 count)
+        requires std::is_trivially_copyable_v<T>
+    {
+        if (m_length + count > m_capacity)
+            grow(file, line, m_length + count);
+
+        T* data = m_data + m_length;
+        m_length += count;
+        return data;
+    }
+#endif
+
     template <IArrT T>
     std::optional<T> dyarr<T>::dyarr_pop() {
         if (m_length > 0) {
@@ -747,6 +876,73 @@ namespace nk::cl {
         return std::move(value);
     }
 
+    template <IArrT T>
+    std::optional<T> dyarr<T>::dyarr_swap_remove(u64 index) {
+        if (index >= m_length) {
+            WarnLog("nk::cl::dyarr::swap_remove Index '{}' out of bounds! Length: {}", index, m_length);
+            return std::nullopt;
+        }
+
+        T value = std::move(m_data[index]);
+        m_length--;
+        if (index != m_length)
+            m_data[index] = std::move(m_data[m_length]);
+
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            m_data[m_length].~T();
+        }
+
+        return value;
+    }
+
+    template <IArrT T>
+    template <typename Predicate>
+    u64 dyarr<T>::dyarr_erase_if(Predicate predicate) {
+        u64 write = 0;
+        for (u64 read = 0; read < m_length; read++) {
+            if (predicate(m_data[read]))
+                continue;
+
+            if (write != read)
+                m_data[write] = std::move(m_data[read]);
+            write++;
+        }
+
+        const u64 removed = m_length - write;
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (u64 i = write; i < m_length; i++) {
+                m_data[i].~T();
+            }
+        }
+
+        m_length = write;
+        return removed;
+    }
+
+    template <IArrT T>
+    void dyarr<T>::open_gap(u64 index, u64 count) {
+        if (index >= m_length)
+            return;
+
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memmove(m_data + index + count, m_data + index, sizeof(T) * (m_length - index));
+        } else {
+            for (u64 i = m_length; i > index; i--) {
+                std::construct_at(m_data + i - 1 + count, std::move(m_data[i - 1]));
+                std::destroy_at(m_data + i - 1);
+            }
+        }
+    }
+
+    template <IArrT T>
+    void dyarr<T>::copy_into(u64 index, const T* values, u64 count) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memcpy(m_data + index, values, sizeof(T) * count);
+        } else {
+            std::uninitialized_copy_n(values, count, m_data + index);
+        }
+    }
+
     template <IArrT T>
     void dyarr<T>::grow(u64 capacity) {
         if (capacity < m_capacity * 2) {
@@ -847,6 +1043,15 @@ namespace nk::cl {
     #define dyarr_resize(length) \
         _dyarr_resize(__FILE__, __LINE__, (length))
 
+    #define dyarr_push_range(values, count) \
+        _dyarr_push_range(__FILE__, __LINE__, (values), (count))
+
+    #define dyarr_insert_range(index, values, count) \
+        _dyarr_insert_range(__FILE__, __LINE__, (index), (values), (count))
+
+    #define dyarr_append_uninitialized(count) \
+        _dyarr_append_uninitialized(__FILE__, __LINE__, (count))
+
 #else
 
     #define dyarr_at(index) \
@@ -856,13 +1061,13 @@ namespace nk::cl {
         _dyarr_init((allocator), (capacity))
 
     #define dyarr_init_len(allocator, capacity, length) \
-        _dyarr_init((allocator), (capacity), (length))
+        _dyarr_init_len((allocator), (capacity), (length))
 
     #define dyarr_init_own(allocator, capacity) \
         _dyarr_init_own((allocator), (capacity))
 
     #define dyarr_init_own_len(allocator, capacity, length) \
-        _dyarr_init_own((allocator), (capacity), (length))
+        _dyarr_init_own_len((allocator), (capacity), (length))
 
     #define dyarr_init_list(allocator, ...) \
         _dyarr_init_list((allocator), __VA_ARGS__)
@@ -897,4 +1102,13 @@ namespace nk::cl {
     #define dyarr_resize(length) \
         _dyarr_resize((length))
 
+    #define dyarr_push_range(values, count) \
+        _dyarr_push_range((values), (count))
+
+    #define dyarr_insert_range(index, values, count) \
+        _dyarr_insert_range((index), (values), (count))
+
+    #define dyarr_append_uninitialized(count) \
+        _dyarr_append_uninitialized((count))
+
 #endif
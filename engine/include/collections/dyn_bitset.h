@@ -0,0 +1,309 @@
+#pragma once
+
+#include "memory/allocator.h"
+#include "collections/bitset.h"
+
+namespace nk::cl {
+    // Bitset sized at runtime, words come from the allocator. Bulk operations
+    // expect both sides to have the same length.
+    class dyn_bitset {
+    public:
+        dyn_bitset()
+            : m_words{nullptr},
+              m_length{0},
+              m_word_capacity{0},
+              m_allocator{nullptr},
+              m_own_allocator{false} {}
+
+        dyn_bitset(dyn_bitset&& other)
+            : m_words{other.m_words},
+              m_length{other.m_length},
+              m_word_capacity{other.m_word_capacity},
+              m_allocator{other.m_allocator},
+              m_own_allocator{other.m_own_allocator} {
+            other.m_words = nullptr;
+            other.m_length = 0;
+            other.m_word_capacity = 0;
+            other.m_allocator = nullptr;
+            other.m_own_allocator = false;
+        }
+
+        dyn_bitset& operator=(dyn_bitset&& other) {
+            m_words = other.m_words;
+            m_length = other.m_length;
+            m_word_capacity = other.m_word_capacity;
+            m_allocator = other.m_allocator;
+            m_own_allocator = other.m_own_allocator;
+
+            other.m_words = nullptr;
+            other.m_length = 0;
+            other.m_word_capacity = 0;
+            other.m_allocator = nullptr;
+            other.m_own_allocator = false;
+
+            return *this;
+        }
+
+        dyn_bitset(const dyn_bitset&) = delete;
+        dyn_bitset& operator=(const dyn_bitset&) = delete;
+
+        ~dyn_bitset() {
+            if (m_allocator != nullptr) {
+                _dyn_bitset_clear();
+                return;
+            }
+            WarnLogIf(m_words != nullptr, "nk::cl::~dyn_bitset not correctly freed.");
+        }
+
+        void _dyn_bitset_init(mem::Allocator* allocator, u64 length) {
+            Assert(allocator != nullptr);
+            m_allocator = allocator;
+            _dyn_bitset_resize(length);
+        }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _dyn_bitset_init(cstr file, u32 line, mem::Allocator* allocator, u64 length) {
+            Assert(allocator != nullptr);
+            m_allocator = allocator;
+            _dyn_bitset_resize(file, line, length);
+        }
+#endif
+
+        void _dyn_bitset_init_own(mem::Allocator* allocator, u64 length) {
+            _dyn_bitset_init(allocator, length);
+            m_own_allocator = true;
+        }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _dyn_bitset_init_own(cstr file, u32 line, mem::Allocator* allocator, u64 length) {
+            _dyn_bitset_init(file, line, allocator, length);
+            m_own_allocator = true;
+        }
+#endif
+
+        void _dyn_bitset_clear() {
+            if (m_words == nullptr)
+                return;
+
+            if (m_allocator == nullptr) {
+                ErrorLog("nk::cl::dyn_bitset::dyn_bitset_clear Trying to clear bitset with no allocator, initialize.");
+                return;
+            }
+
+            m_allocator->free_lot_t(u64, m_words, m_word_capacity);
+            m_words = nullptr;
+            m_length = 0;
+            m_word_capacity = 0;
+        }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _dyn_bitset_clear(cstr file, u32 line) {
+            if (m_words == nullptr)
+                return;
+
+            if (m_allocator == nullptr) {
+                ErrorLog("nk::cl::dyn_bitset::dyn_bitset_clear Trying to clear bitset with no allocator, initialize.");
+                return;
+            }
+
+            m_allocator->_free_lot_t<u64>(file, line, m_words, m_word_capacity);
+            m_words = nullptr;
+            m_length = 0;
+            m_word_capacity = 0;
+        }
+#endif
+
+        void _dyn_bitset_shutdown() {
+            _dyn_bitset_clear();
+
+            if (m_own_allocator)
+                native_deconstruct(mem::Allocator, m_allocator);
+
+            m_allocator = nullptr;
+            m_own_allocator = false;
+        }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _dyn_bitset_shutdown(cstr file, u32 line) {
+            _dyn_bitset_clear(file, line);
+
+            if (m_own_allocator)
+                os::_native_deconstruct<mem::Allocator>(file, line, m_allocator);
+
+            m_allocator = nullptr;
+            m_own_allocator = false;
+        }
+#endif
+
+        // New bits start cleared.
+        void _dyn_bitset_resize(u64 length) {
+            const u64 word_count = bits::word_count(length);
+            if (word_count > m_word_capacity) {
+                u64* words = m_allocator->allocate_lot_t(u64, word_count);
+                move_words(words, word_count);
+                if (m_words != nullptr)
+                    m_allocator->free_lot_t(u64, m_words, m_word_capacity);
+                m_words = words;
+                m_word_capacity = word_count;
+            }
+            set_length(length);
+        }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _dyn_bitset_resize(cstr file, u32 line, u64 length) {
+            const u64 word_count = bits::word_count(length);
+            if (word_count > m_word_capacity) {
+                u64* words = m_allocator->_allocate_lot_t<u64>(file, line, word_count);
+                move_words(words, word_count);
+                if (m_words != nullptr)
+                    m_allocator->_free_lot_t<u64>(file, line, m_words, m_word_capacity);
+                m_words = words;
+                m_word_capacity = word_count;
+            }
+            set_length(length);
+        }
+#endif
+
+        bool operator[](const u64 bit) const { return test(bit); }
+
+        bool test(const u64 bit) const {
+            Assert(bit < m_length);
+            return (m_words[bits::word_index(bit)] & bits::bit_mask(bit)) != 0;
+        }
+
+        void set(const u64 bit) {
+            Assert(bit < m_length);
+            m_words[bits::word_index(bit)] |= bits::bit_mask(bit);
+        }
+
+        void set(const u64 bit, const bool value) {
+            if (value) {
+                set(bit);
+            } else {
+                reset(bit);
+            }
+        }
+
+        void reset(const u64 bit) {
+            Assert(bit < m_length);
+            m_words[bits::word_index(bit)] &= ~bits::bit_mask(bit);
+        }
+
+        void flip(const u64 bit) {
+            Assert(bit < m_length);
+            m_words[bits::word_index(bit)] ^= bits::bit_mask(bit);
+        }
+
+        void set_all() {
+            if (m_length == 0)
+                return;
+            std::memset(m_words, 0xFF, sizeof(u64) * word_count());
+            m_words[word_count() - 1] &= bits::tail_mask(m_length);
+        }
+
+        void reset_all() { std::memset(m_words, 0, sizeof(u64) * word_count()); }
+
+        u64 count() const { return bits::popcount(m_words, word_count()); }
+        bool any() const { return bits::any(m_words, word_count()); }
+        bool none() const { return !any(); }
+        bool all() const { return count() == m_length; }
+
+        // Returns length() when no bit is set.
+        u64 find_first() const { return bits::find_next(m_words, m_length, 0); }
+        u64 find_next(const u64 from) const { return bits::find_next(m_words, m_length, from); }
+
+        template <typename Func>
+        void for_each_set(Func&& func) const {
+            bits::for_each_set(m_words, word_count(), std::forward<Func>(func));
+        }
+
+        dyn_bitset& operator&=(const dyn_bitset& other) { return apply<bits::Op::And>(other); }
+        dyn_bitset& operator|=(const dyn_bitset& other) { return apply<bits::Op::Or>(other); }
+        dyn_bitset& operator^=(const dyn_bitset& other) { return apply<bits::Op::Xor>(other); }
+
+        // Clears every bit that is set in other.
+        dyn_bitset& and_not(const dyn_bitset& other) { return apply<bits::Op::AndNot>(other); }
+
+        bool operator==(const dyn_bitset& other) const {
+            return m_length == other.m_length &&
+                   std::memcmp(m_words, other.m_words, sizeof(u64) * word_count()) == 0;
+        }
+
+        u64* words() { return m_words; }
+        const u64* words() const { return m_words; }
+        u64 word_count() const { return bits::word_count(m_length); }
+
+        u64 length() const { return m_length; }
+        bool empty() const { return m_length == 0; }
+        mem::Allocator* allocator() { return m_allocator; }
+        bool owns_allocator() const { return m_own_allocator; }
+
+    private:
+        template <bits::Op O>
+        dyn_bitset& apply(const dyn_bitset& other) {
+            Assert(m_length == other.m_length);
+            bits::apply<O>(m_words, m_words, other.m_words, word_count());
+            return *this;
+        }
+
+        void move_words(u64* words, u64 word_count) {
+            const u64 kept = this->word_count();
+            if (kept > 0)
+                std::memcpy(words, m_words, sizeof(u64) * kept);
+            std::memset(words + kept, 0, sizeof(u64) * (word_count - kept));
+        }
+
+        // Keeps the bits past length cleared so counts and compares stay word based.
+        void set_length(u64 length) {
+            const u64 old_words = word_count();
+            const u64 new_words = bits::word_count(length);
+            if (new_words > old_words)
+                std::memset(m_words + old_words, 0, sizeof(u64) * (new_words - old_words));
+            if (length < m_length && new_words > 0)
+                m_words[new_words - 1] &= bits::tail_mask(length);
+            m_length = length;
+        }
+
+        u64* m_words;
+        u64 m_length;
+        u64 m_word_capacity;
+        mem::Allocator* m_allocator;
+        bool m_own_allocator;
+    };
+}
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+
+    #define dyn_bitset_init(allocator, length) \
+        _dyn_bitset_init(__FILE__, __LINE__, (allocator), (length))
+
+    #define dyn_bitset_init_own(allocator, length) \
+        _dyn_bitset_init_own(__FILE__, __LINE__, (allocator), (length))
+
+    #define dyn_bitset_clear() \
+        _dyn_bitset_clear(__FILE__, __LINE__)
+
+    #define dyn_bitset_shutdown() \
+        _dyn_bitset_shutdown(__FILE__, __LINE__)
+
+    #define dyn_bitset_resize(length) \
+        _dyn_bitset_resize(__FILE__, __LINE__, (length))
+
+#else
+
+    #define dyn_bitset_init(allocator, length) \
+        _dyn_bitset_init((allocator), (length))
+
+    #define dyn_bitset_init_own(allocator, length) \
+        _dyn_bitset_init_own((allocator), (length))
+
+    #define dyn_bitset_clear() \
+        _dyn_bitset_clear()
+
+    #define dyn_bitset_shutdown() \
+        _dyn_bitset_shutdown()
+
+    #define dyn_bitset_resize(length) \
+        _dyn_bitset_resize((length))
+
+#endif
@@ -0,0 +1,84 @@
+#pragma once
+
+namespace nk::cl {
+    // Bounded lock-free queue for many producer threads and one consumer
+    // thread, with inline storage so it never allocates. Every cell carries a
+    // sequence number that tells producers whether it is free for the current
+    // lap and the consumer whether it has been written (Vyukov's bounded
+    // queue). A push on a full queue fails instead of waiting.
+    template <typename T, u64 Capacity>
+        requires(std::has_single_bit(Capacity) && std::is_default_constructible_v<T>)
+    class mpsc_queue {
+    public:
+        static constexpr u64 cache_line = 64;
+
+        mpsc_queue()
+            : m_tail{0},
+              m_head{0} {
+            for (u64 i = 0; i < Capacity; i++) {
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        mpsc_queue(const mpsc_queue&) = delete;
+        mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+        ~mpsc_queue() = default;
+
+        // Safe from any thread, returns false when the queue is full.
+        bool mpsc_queue_push(const T& value) {
+            u64 position = m_tail.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &m_cells[position & mask];
+                const u64 sequence = cell->sequence.load(std::memory_order_acquire);
+                const i64 difference = static_cast<i64>(sequence) - static_cast<i64>(position);
+                if (difference == 0) {
+                    if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->value = value;
+            cell->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer thread only.
+        bool mpsc_queue_pop(T& out_value) {
+            Cell& cell = m_cells[m_head & mask];
+            if (cell.sequence.load(std::memory_order_acquire) != m_head + 1)
+                return false;
+
+            out_value = std::move(cell.value);
+            cell.sequence.store(m_head + Capacity, std::memory_order_release);
+            m_head++;
+            return true;
+        }
+
+        // Consumer thread only, producers may push more in the meantime.
+        u64 approximate_length() const {
+            const u64 tail = m_tail.load(std::memory_order_relaxed);
+            return tail > m_head ? tail - m_head : 0;
+        }
+
+        static constexpr u64 capacity() { return Capacity; }
+
+    private:
+        static constexpr u64 mask = Capacity - 1;
+
+        struct Cell {
+            std::atomic<u64> sequence;
+            T value;
+        };
+
+        // Producers and the consumer touch different lines.
+        alignas(cache_line) std::atomic<u64> m_tail;
+        alignas(cache_line) u64 m_head;
+        alignas(cache_line) Cell m_cells[Capacity];
+    };
+}
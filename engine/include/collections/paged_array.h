@@ -0,0 +1,561 @@
+#pragma once
+
+#include "memory/allocator.h"
+#include "collections/arr_type.h"
+
+namespace nk::cl {
+    // Array made of fixed-size pages. Appending never relocates existing
+    // elements, so references and pointers stay valid until the element is
+    // removed or the array is cleared. Only the page table grows.
+    template <IArrT T, u64 PageSize = 1024>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    class paged_array {
+    public:
+        static constexpr u64 page_size = PageSize;
+        static constexpr u64 page_shift = std::countr_zero(PageSize);
+        static constexpr u64 page_mask = PageSize - 1;
+
+        class iterator {
+        public:
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+
+            iterator(paged_array* owner, u64 index)
+                : m_owner{owner},
+                  m_index{index} {}
+
+            T& operator*() const { return m_owner->m_pages[m_index >> page_shift][m_index & page_mask]; }
+            T* operator->() const { return &**this; }
+
+            iterator& operator++() {
+                m_index++;
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator previous = *this;
+                m_index++;
+                return previous;
+            }
+
+            bool operator==(const iterator& other) const { return m_index == other.m_index; }
+            bool operator!=(const iterator& other) const { return m_index != other.m_index; }
+
+        private:
+            paged_array* m_owner;
+            u64 m_index;
+        };
+
+        paged_array();
+
+        paged_array(paged_array&& other);
+        paged_array& operator=(paged_array&& other);
+
+        paged_array(const paged_array&) = delete;
+        paged_array& operator=(const paged_array&) = delete;
+
+        ~paged_array();
+
+        T& operator[](const u64 index);
+        const T& operator[](const u64 index) const;
+
+        void _paged_array_init(mem::Allocator* allocator, u64 capacity);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _paged_array_init(cstr file, u32 line, mem::Allocator* allocator, u64 capacity);
+#endif
+
+        void _paged_array_init_own(mem::Allocator* allocator, u64 capacity);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _paged_array_init_own(cstr file, u32 line, mem::Allocator* allocator, u64 capacity);
+#endif
+
+        void _paged_array_clear();
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _paged_array_clear(cstr file, u32 line);
+#endif
+
+        void _paged_array_shutdown();
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _paged_array_shutdown(cstr file, u32 line);
+#endif
+
+        T& _paged_array_push(T& value);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        T& _paged_array_push(cstr file, u32 line, T& value);
+#endif
+
+        T& _paged_array_push_copy(const T& value);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        T& _paged_array_push_copy(cstr file, u32 line, const T& value);
+#endif
+
+        void _paged_array_resize(u64 length);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _paged_array_resize(cstr file, u32 line, u64 length);
+#endif
+
+        std::optional<T> paged_array_pop();
+
+        // Destroys every element but keeps the pages for reuse.
+        void paged_array_reset();
+
+        T& paged_array_first();
+        T& paged_array_last();
+
+        iterator begin() { return iterator(this, 0); }
+        iterator end() { return iterator(this, m_length); }
+
+        // Pages are contiguous blocks of page_size elements, the last used one may be partially used
+        // and reserved pages past it are empty.
+        T* page(const u64 page_index) { return m_pages[page_index]; }
+        u64 page_length(const u64 page_index) const {
+            const u64 start = page_index << page_shift;
+            if (start >= m_length)
+                return 0;
+            return m_length - start >= PageSize ? PageSize : m_length - start;
+        }
+
+        u64 length() const { return m_length; }
+        u64 capacity() const { return m_page_count << page_shift; }
+        u64 page_count() const { return m_page_count; }
+        u64 used_page_count() const { return (m_length + page_mask) >> page_shift; }
+        bool empty() const { return m_length == 0; }
+        mem::Allocator* allocator() { return m_allocator; }
+        bool owns_allocator() const { return m_own_allocator; }
+
+    private:
+        void destroy_range(u64 from, u64 to);
+
+        void add_pages(u64 page_count);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void add_pages(cstr file, u32 line, u64 page_count);
+#endif
+
+        T** m_pages;
+        u64 m_page_count;
+        u64 m_page_table_capacity;
+        u64 m_length;
+        mem::Allocator* m_allocator;
+        bool m_own_allocator;
+    };
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    paged_array<T, PageSize>::paged_array()
+        : m_pages{nullptr},
+          m_page_count{0},
+          m_page_table_capacity{0},
+          m_length{0},
+          m_allocator{nullptr},
+          m_own_allocator{false} {}
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    paged_array<T, PageSize>::paged_array(paged_array&& other)
+        : m_pages{other.m_pages},
+          m_page_count{other.m_page_count},
+          m_page_table_capacity{other.m_page_table_capacity},
+          m_length{other.m_length},
+          m_allocator{other.m_allocator},
+          m_own_allocator{other.m_own_allocator} {
+        other.m_pages = nullptr;
+        other.m_page_count = 0;
+        other.m_page_table_capacity = 0;
+        other.m_length = 0;
+        other.m_allocator = nullptr;
+        other.m_own_allocator = false;
+    }
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    paged_array<T, PageSize>& paged_array<T, PageSize>::operator=(paged_array&& other) {
+        m_pages = other.m_pages;
+        m_page_count = other.m_page_count;
+        m_page_table_capacity = other.m_page_table_capacity;
+        m_length = other.m_length;
+        m_allocator = other.m_allocator;
+        m_own_allocator = other.m_own_allocator;
+
+        other.m_pages = nullptr;
+        other.m_page_count = 0;
+        other.m_page_table_capacity = 0;
+        other.m_length = 0;
+        other.m_allocator = nullptr;
+        other.m_own_allocator = false;
+
+        return *this;
+    }
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    paged_array<T, PageSize>::~paged_array() {
+        if (m_allocator != nullptr) {
+            _paged_array_clear();
+            return;
+        }
+        WarnLogIf(m_pages != nullptr, "nk::cl::~paged_array not correctly freed.");
+    }
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    T& paged_array<T, PageSize>::operator[](const u64 index) {
+        Assert(index < m_length);
+        return m_pages[index >> page_shift][index & page_mask];
+    }
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    const T& paged_array<T, PageSize>::operator[](const u64 index) const {
+        Assert(index < m_length);
+        return m_pages[index >> page_shift][index & page_mask];
+    }
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void paged_array<T, PageSize>::_paged_array_init(mem::Allocator* allocator, u64 capacity) {
+        Assert(allocator != nullptr);
+        m_allocator = allocator;
+        add_pages((capacity + page_mask) >> page_shift);
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void paged_array<T, PageSize>::_paged_array_init(cstr file, u32 line, mem::Allocator* allocator, u64 capacity) {
+        Assert(allocator != nullptr);
+        m_allocator = allocator;
+        add_pages(file, line, (capacity + page_mask) >> page_shift);
+    }
+#endif
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void paged_array<T, PageSize>::_paged_array_init_own(mem::Allocator* allocator, u64 capacity) {
+        Assert(allocator != nullptr);
+        m_allocator = allocator;
+        m_own_allocator = true;
+        add_pages((capacity + page_mask) >> page_shift);
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void paged_array<T, PageSize>::_paged_array_init_own(cstr file, u32 line, mem::Allocator* allocator, u64 capacity) {
+        Assert(allocator != nullptr);
+        m_allocator = allocator;
+        m_own_allocator = true;
+        add_pages(file, line, (capacity + page_mask) >> page_shift);
+    }
+#endif
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void paged_array<T, PageSize>::_paged_array_clear() {
+        if (m_pages == nullptr)
+            return;
+
+        if (m_allocator == nullptr) {
+            ErrorLog("nk::cl::paged_array::paged_array_clear Trying to clear array with no allocator, initialize.");
+            return;
+        }
+
+        destroy_range(0, m_length);
+
+        for (u64 i = 0; i < m_page_count; i++) {
+            m_allocator->free_lot_t(T, m_pages[i], PageSize);
+        }
+        m_allocator->free_lot_t(T*, m_pages, m_page_table_capacity);
+
+        m_pages = nullptr;
+        m_page_count = 0;
+        m_page_table_capacity = 0;
+        m_length = 0;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void paged_array<T, PageSize>::_paged_array_clear(cstr file, u32 line) {
+        if (m_pages == nullptr)
+            return;
+
+        if (m_allocator == nullptr) {
+            ErrorLog("nk::cl::paged_array::paged_array_clear Trying to clear array with no allocator, initialize.");
+            return;
+        }
+
+        destroy_range(0, m_length);
+
+        for (u64 i = 0; i < m_page_count; i++) {
+            m_allocator->_free_lot_t<T>(file, line, m_pages[i], PageSize);
+        }
+        m_allocator->_free_lot_t<T*>(file, line, m_pages, m_page_table_capacity);
+
+        m_pages = nullptr;
+        m_page_count = 0;
+        m_page_table_capacity = 0;
+        m_length = 0;
+    }
+#endif
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void paged_array<T, PageSize>::_paged_array_shutdown() {
+        _paged_array_clear();
+
+        if (m_own_allocator)
+            native_deconstruct(mem::Allocator, m_allocator);
+
+        m_allocator = nullptr;
+        m_own_allocator = false;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void paged_array<T, PageSize>::_paged_array_shutdown(cstr file, u32 line) {
+        _paged_array_clear(file, line);
+
+        if (m_own_allocator)
+            os::_native_deconstruct<mem::Allocator>(file, line, m_allocator);
+
+        m_allocator = nullptr;
+        m_own_allocator = false;
+    }
+#endif
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    T& paged_array<T, PageSize>::_paged_array_push(T& value) {
+        if (m_length >= capacity())
+            add_pages(1);
+
+        T* slot = &m_pages[m_length >> page_shift][m_length & page_mask];
+        std::construct_at(slot, std::move(value));
+        m_length++;
+        return *slot;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    T& paged_array<T, PageSize>::_paged_array_push(cstr file, u32 line, T& value) {
+        if (m_length >= capacity())
+            add_pages(file, line, 1);
+
+        T* slot = &m_pages[m_length >> page_shift][m_length & page_mask];
+        std::construct_at(slot, std::move(value));
+        m_length++;
+        return *slot;
+    }
+#endif
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    T& paged_array<T, PageSize>::_paged_array_push_copy(const T& value) {
+        if (m_length >= capacity())
+            add_pages(1);
+
+        T* slot = &m_pages[m_length >> page_shift][m_length & page_mask];
+        std::construct_at(slot, value);
+        m_length++;
+        return *slot;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    T& paged_array<T, PageSize>::_paged_array_push_copy(cstr file, u32 line, const T& value) {
+        if (m_length >= capacity())
+            add_pages(file, line, 1);
+
+        T* slot = &m_pages[m_length >> page_shift][m_length & page_mask];
+        std::construct_at(slot, value);
+        m_length++;
+        return *slot;
+    }
+#endif
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void paged_array<T, PageSize>::_paged_array_resize(u64 length) {
+        if (length > capacity())
+            add_pages(((length + page_mask) >> page_shift) - m_page_count);
+
+        if (length > m_length) {
+            for (u64 i = m_length; i < length; i++) {
+                std::construct_at(&m_pages[i >> page_shift][i & page_mask]);
+            }
+        } else {
+            destroy_range(length, m_length);
+        }
+        m_length = length;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void paged_array<T, PageSize>::_paged_array_resize(cstr file, u32 line, u64 length) {
+        if (length > capacity())
+            add_pages(file, line, ((length + page_mask) >> page_shift) - m_page_count);
+
+        if (length > m_length) {
+            for (u64 i = m_length; i < length; i++) {
+                std::construct_at(&m_pages[i >> page_shift][i & page_mask]);
+            }
+        } else {
+            destroy_range(length, m_length);
+        }
+        m_length = length;
+    }
+#endif
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    std::optional<T> paged_array<T, PageSize>::paged_array_pop() {
+        if (m_length == 0)
+            return std::nullopt;
+
+        m_length--;
+        T* slot = &m_pages[m_length >> page_shift][m_length & page_mask];
+        std::optional<T> value = std::move(*slot);
+        std::destroy_at(slot);
+        return value;
+    }
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void paged_array<T, PageSize>::paged_array_reset() {
+        destroy_range(0, m_length);
+        m_length = 0;
+    }
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    T& paged_array<T, PageSize>::paged_array_first() {
+        Assert(m_length > 0, "nk::cl::paged_array::paged_array_first Array is empty!");
+        return m_pages[0][0];
+    }
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    T& paged_array<T, PageSize>::paged_array_last() {
+        Assert(m_length > 0, "nk::cl::paged_array::paged_array_last Array is empty!");
+        const u64 index = m_length - 1;
+        return m_pages[index >> page_shift][index & page_mask];
+    }
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void paged_array<T, PageSize>::destroy_range(u64 from, u64 to) {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (u64 i = from; i < to; i++) {
+                std::destroy_at(&m_pages[i >> page_shift][i & page_mask]);
+            }
+        }
+    }
+
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void paged_array<T, PageSize>::add_pages(u64 page_count) {
+        const u64 required = m_page_count + page_count;
+        if (required > m_page_table_capacity) {
+            u64 table_capacity = m_page_table_capacity * 2;
+            if (table_capacity < required)
+                table_capacity = required;
+            if (table_capacity < 4)
+                table_capacity = 4;
+
+            T** pages = m_allocator->allocate_lot_t(T*, table_capacity);
+            if (m_page_count > 0)
+                std::memcpy(pages, m_pages, sizeof(T*) * m_page_count);
+            if (m_page_table_capacity > 0)
+                m_allocator->free_lot_t(T*, m_pages, m_page_table_capacity);
+
+            m_pages = pages;
+            m_page_table_capacity = table_capacity;
+        }
+
+        for (u64 i = m_page_count; i < required; i++) {
+            m_pages[i] = m_allocator->allocate_lot_t(T, PageSize);
+        }
+        m_page_count = required;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT T, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void paged_array<T, PageSize>::add_pages(cstr file, u32 line, u64 page_count) {
+        const u64 required = m_page_count + page_count;
+        if (required > m_page_table_capacity) {
+            u64 table_capacity = m_page_table_capacity * 2;
+            if (table_capacity < required)
+                table_capacity = required;
+            if (table_capacity < 4)
+                table_capacity = 4;
+
+            T** pages = m_allocator->_allocate_lot_t<T*>(file, line, table_capacity);
+            if (m_page_count > 0)
+                std::memcpy(pages, m_pages, sizeof(T*) * m_page_count);
+            if (m_page_table_capacity > 0)
+                m_allocator->_free_lot_t<T*>(file, line, m_pages, m_page_table_capacity);
+
+            m_pages = pages;
+            m_page_table_capacity = table_capacity;
+        }
+
+        for (u64 i = m_page_count; i < required; i++) {
+            m_pages[i] = m_allocator->_allocate_lot_t<T>(file, line, PageSize);
+        }
+        m_page_count = required;
+    }
+#endif
+}
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+
+    #define paged_array_init(allocator, capacity) \
+        _paged_array_init(__FILE__, __LINE__, (allocator), (capacity))
+
+    #define paged_array_init_own(allocator, capacity) \
+        _paged_array_init_own(__FILE__, __LINE__, (allocator), (capacity))
+
+    #define paged_array_clear() \
+        _paged_array_clear(__FILE__, __LINE__)
+
+    #define paged_array_shutdown() \
+        _paged_array_shutdown(__FILE__, __LINE__)
+
+    #define paged_array_push(value) \
+        _paged_array_push(__FILE__, __LINE__, (value))
+
+    #define paged_array_push_copy(...) \
+        _paged_array_push_copy(__FILE__, __LINE__, (__VA_ARGS__))
+
+    #define paged_array_resize(length) \
+        _paged_array_resize(__FILE__, __LINE__, (length))
+
+#else
+
+    #define paged_array_init(allocator, capacity) \
+        _paged_array_init((allocator), (capacity))
+
+    #define paged_array_init_own(allocator, capacity) \
+        _paged_array_init_own((allocator), (capacity))
+
+    #define paged_array_clear() \
+        _paged_array_clear()
+
+    #define paged_array_shutdown() \
+        _paged_array_shutdown()
+
+    #define paged_array_push(value) \
+        _paged_array_push((value))
+
+    #define paged_array_push_copy(...) \
+        _paged_array_push_copy((__VA_ARGS__))
+
+    #define paged_array_resize(length) \
+        _paged_array_resize((length))
+
+#endif
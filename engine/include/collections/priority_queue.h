@@ -0,0 +1,254 @@
+#pragma once
+
+#include "collections/dyarr.h"
+
+namespace nk::cl {
+    // 4-ary heap stored in a dyarr. The top is the element for which Compare
+    // holds against every other one (the smallest with std::less). Four
+    // children per node halve the depth of a binary heap and keep siblings in
+    // the same cache line for small T.
+    //
+    // Push returns a handle that stays valid until the element leaves the
+    // queue, update and remove use it to reach the element in O(log n).
+    // Handles are recycled once their element is popped or removed.
+    template <IArrT T, typename Compare = std::less<T>>
+    class priority_queue {
+    public:
+        using handle = u32;
+
+        static constexpr u64 arity = 4;
+        static constexpr handle invalid_handle = std::numeric_limits<handle>::max();
+
+        priority_queue()
+            : m_free_head{invalid_handle},
+              m_compare{} {}
+
+        priority_queue(priority_queue&& other) = default;
+        priority_queue& operator=(priority_queue&& other) = default;
+
+        priority_queue(const priority_queue&) = delete;
+        priority_queue& operator=(const priority_queue&) = delete;
+
+        ~priority_queue() = default;
+
+        void _priority_queue_init(mem::Allocator* allocator, u64 capacity) {
+            m_heap._dyarr_init(allocator, capacity);
+            m_positions._dyarr_init(allocator, capacity);
+            m_free_head = invalid_handle;
+        }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _priority_queue_init(cstr file, u32 line, mem::Allocator* allocator, u64 capacity) {
+            m_heap._dyarr_init(file, line, allocator, capacity);
+            m_positions._dyarr_init(file, line, allocator, capacity);
+            m_free_head = invalid_handle;
+        }
+#endif
+
+        void _priority_queue_shutdown() {
+            m_heap._dyarr_shutdown();
+            m_positions._dyarr_shutdown();
+            m_free_head = invalid_handle;
+        }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _priority_queue_shutdown(cstr file, u32 line) {
+            m_heap._dyarr_shutdown(file, line);
+            m_positions._dyarr_shutdown(file, line);
+            m_free_head = invalid_handle;
+        }
+#endif
+
+        handle _priority_queue_push(T value) {
+            const handle id = acquire_handle();
+            if (id == m_positions.length())
+                m_positions._dyarr_push_copy(0);
+
+            m_heap._dyarr_push_copy(Node{.value = std::move(value), .id = id});
+            sift_up(m_heap.length() - 1);
+            return id;
+        }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        handle _priority_queue_push(cstr file, u32 line, T value) {
+            const handle id = acquire_handle();
+            if (id == m_positions.length())
+                m_positions._dyarr_push_copy(file, line, 0);
+
+            m_heap._dyarr_push_copy(file, line, Node{.value = std::move(value), .id = id});
+            sift_up(m_heap.length() - 1);
+            return id;
+        }
+#endif
+
+        std::optional<T> priority_queue_pop() {
+            if (m_heap.empty())
+                return std::nullopt;
+
+            return take(0);
+        }
+
+        // Replaces the value of a queued element and moves it up or down to
+        // its new place, which covers decrease-key and increase-key.
+        bool priority_queue_update(handle id, T value) {
+            if (!contains(id))
+                return false;
+
+            const u64 index = m_positions[id];
+            const bool moves_up = m_compare(value, m_heap[index].value);
+            m_heap[index].value = std::move(value);
+            if (moves_up) {
+                sift_up(index);
+            } else {
+                sift_down(index);
+            }
+            return true;
+        }
+
+        std::optional<T> priority_queue_remove(handle id) {
+            if (!contains(id))
+                return std::nullopt;
+
+            return take(m_positions[id]);
+        }
+
+        void priority_queue_reset() {
+            m_heap.dyarr_reset();
+            m_positions.dyarr_reset();
+            m_free_head = invalid_handle;
+        }
+
+        const T& top() const {
+            Assert(!m_heap.empty(), "nk::cl::priority_queue::top Queue is empty!");
+            return m_heap[0].value;
+        }
+
+        handle top_handle() const {
+            Assert(!m_heap.empty(), "nk::cl::priority_queue::top_handle Queue is empty!");
+            return m_heap[0].id;
+        }
+
+        const T& get(handle id) const {
+            Assert(contains(id));
+            return m_heap[m_positions[id]].value;
+        }
+
+        bool contains(handle id) const { return id < m_positions.length() && (m_positions[id] & free_tag) == 0; }
+
+        u64 length() const { return m_heap.length(); }
+        bool empty() const { return m_heap.empty(); }
+
+    private:
+        struct Node {
+            T value;
+            handle id;
+        };
+
+        // Positions of released handles hold free_tag | next free handle.
+        static constexpr u32 free_tag = 1u << 31;
+
+        handle acquire_handle() {
+            if (m_free_head == invalid_handle)
+                return static_cast<handle>(m_positions.length());
+
+            const handle id = m_free_head;
+            const u32 next = m_positions[id] & ~free_tag;
+            m_free_head = next == (invalid_handle & ~free_tag) ? invalid_handle : next;
+            return id;
+        }
+
+        void release_handle(handle id) {
+            m_positions[id] = free_tag | (m_free_head & ~free_tag);
+            m_free_head = id;
+        }
+
+        T take(u64 index) {
+            Node& node = m_heap[index];
+            T value = std::move(node.value);
+            release_handle(node.id);
+
+            Node last = std::move(m_heap.dyarr_last());
+            m_heap.dyarr_pop();
+            if (index < m_heap.length()) {
+                place(index, last);
+                if (index > 0 && m_compare(m_heap[index].value, m_heap[(index - 1) / arity].value)) {
+                    sift_up(index);
+                } else {
+                    sift_down(index);
+                }
+            }
+            return value;
+        }
+
+        void place(u64 index, Node& node) {
+            m_positions[node.id] = static_cast<u32>(index);
+            m_heap[index] = std::move(node);
+        }
+
+        void sift_up(u64 index) {
+            Node node = std::move(m_heap[index]);
+            while (index > 0) {
+                const u64 parent = (index - 1) / arity;
+                if (!m_compare(node.value, m_heap[parent].value))
+                    break;
+
+                place(index, m_heap[parent]);
+                index = parent;
+            }
+            place(index, node);
+        }
+
+        void sift_down(u64 index) {
+            const u64 length = m_heap.length();
+            Node node = std::move(m_heap[index]);
+            while (true) {
+                const u64 first_child = index * arity + 1;
+                if (first_child >= length)
+                    break;
+
+                u64 best = first_child;
+                const u64 last_child = MinValue(first_child + arity, length);
+                for (u64 child = first_child + 1; child < last_child; child++) {
+                    if (m_compare(m_heap[child].value, m_heap[best].value))
+                        best = child;
+                }
+
+                if (!m_compare(m_heap[best].value, node.value))
+                    break;
+
+                place(index, m_heap[best]);
+                index = best;
+            }
+            place(index, node);
+        }
+
+        dyarr<Node> m_heap;
+        dyarr<u32> m_positions;
+        handle m_free_head;
+        [[no_unique_address]] Compare m_compare;
+    };
+}
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+
+    #define priority_queue_init(allocator, capacity) \
+        _priority_queue_init(__FILE__, __LINE__, (allocator), (capacity))
+
+    #define priority_queue_shutdown() \
+        _priority_queue_shutdown(__FILE__, __LINE__)
+
+    #define priority_queue_push(value) \
+        _priority_queue_push(__FILE__, __LINE__, (value))
+
+#else
+
+    #define priority_queue_init(allocator, capacity) \
+        _priority_queue_init((allocator), (capacity))
+
+    #define priority_queue_shutdown() \
+        _priority_queue_shutdown()
+
+    #define priority_queue_push(value) \
+        _priority_queue_push((value))
+
+#endif
@@ -0,0 +1,604 @@
+#pragma once
+
+#include "memory/allocator.h"
+#include "collections/arr_type.h"
+
+namespace nk::cl {
+    // Dynamic array that stores every field in its own contiguous column.
+    // All columns live in a single allocation and every column starts on a
+    // soa_alignment boundary, so a system can stream only the fields it touches.
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    class soa_dyarr {
+    public:
+        static constexpr u64 column_count = sizeof...(Ts);
+        static constexpr u64 soa_alignment = 64;
+
+        template <u64 I>
+        using column_t = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+        template <u64... Is>
+        class zip_range {
+        public:
+            class iterator {
+            public:
+                using value_type = std::tuple<column_t<Is>&...>;
+                using difference_type = std::ptrdiff_t;
+
+                iterator(soa_dyarr* owner, u64 index)
+                    : m_owner{owner},
+                      m_index{index} {}
+
+                value_type operator*() const { return value_type{m_owner->template column<Is>()[m_index]...}; }
+
+                iterator& operator++() {
+                    m_index++;
+                    return *this;
+                }
+
+                iterator operator++(int) {
+                    iterator previous = *this;
+                    m_index++;
+                    return previous;
+                }
+
+                bool operator==(const iterator& other) const { return m_index == other.m_index; }
+                bool operator!=(const iterator& other) const { return m_index != other.m_index; }
+
+                u64 index() const { return m_index; }
+
+            private:
+                soa_dyarr* m_owner;
+                u64 m_index;
+            };
+
+            zip_range(soa_dyarr* owner)
+                : m_owner{owner} {}
+
+            iterator begin() const { return iterator(m_owner, 0); }
+            iterator end() const { return iterator(m_owner, m_owner->length()); }
+
+        private:
+            soa_dyarr* m_owner;
+        };
+
+        soa_dyarr();
+
+        soa_dyarr(soa_dyarr&& other);
+        soa_dyarr& operator=(soa_dyarr&& other);
+
+        soa_dyarr(const soa_dyarr&) = delete;
+        soa_dyarr& operator=(const soa_dyarr&) = delete;
+
+        ~soa_dyarr();
+
+        void _soa_dyarr_init(mem::Allocator* allocator, u64 capacity);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _soa_dyarr_init(cstr file, u32 line, mem::Allocator* allocator, u64 capacity);
+#endif
+
+        void _soa_dyarr_clear();
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _soa_dyarr_clear(cstr file, u32 line);
+#endif
+
+        void _soa_dyarr_shutdown();
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _soa_dyarr_shutdown(cstr file, u32 line);
+#endif
+
+        void _soa_dyarr_reserve(u64 capacity);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _soa_dyarr_reserve(cstr file, u32 line, u64 capacity);
+#endif
+
+        void _soa_dyarr_push(Ts... values);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _soa_dyarr_push(cstr file, u32 line, Ts... values);
+#endif
+
+        void _soa_dyarr_resize(u64 length);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _soa_dyarr_resize(cstr file, u32 line, u64 length);
+#endif
+
+        bool soa_dyarr_pop();
+        bool soa_dyarr_remove(u64 index);
+        bool soa_dyarr_swap_remove(u64 index);
+
+        void soa_dyarr_reset();
+
+        std::tuple<Ts&...> operator[](const u64 index);
+        std::tuple<const Ts&...> operator[](const u64 index) const;
+
+        template <u64 I>
+        column_t<I>& get(const u64 index) {
+            Assert(index < m_length);
+            return column<I>()[index];
+        }
+
+        template <u64 I>
+        const column_t<I>& get(const u64 index) const {
+            Assert(index < m_length);
+            return column<I>()[index];
+        }
+
+        template <u64 I>
+        column_t<I>* column() { return static_cast<column_t<I>*>(m_columns[I]); }
+
+        template <u64 I>
+        const column_t<I>* column() const { return static_cast<const column_t<I>*>(m_columns[I]); }
+
+        template <u64... Is>
+        zip_range<Is...> zip() { return zip_range<Is...>(this); }
+
+        // Calls func with one reference per requested column for every element.
+        template <u64... Is, typename Func>
+        void for_each(Func&& func) {
+            const u64 length = m_length;
+            [&](column_t<Is>*... columns) {
+                for (u64 i = 0; i < length; i++) {
+                    func(columns[i]...);
+                }
+            }(column<Is>()...);
+        }
+
+        u64 length() const { return m_length; }
+        u64 capacity() const { return m_capacity; }
+        bool empty() const { return m_length == 0; }
+        mem::Allocator* allocator() { return m_allocator; }
+        bool owns_allocator() const { return m_own_allocator; }
+
+    private:
+        static constexpr u64 align_up(u64 value) {
+            return (value + soa_alignment - 1) & ~(soa_alignment - 1);
+        }
+
+        static constexpr u64 block_size(u64 capacity) {
+            u64 size = 0;
+            ((size = align_up(size) + sizeof(Ts) * capacity), ...);
+            return align_up(size) + soa_alignment;
+        }
+
+        void place_columns(void* block, u64 capacity, void** out_columns) const;
+
+        template <u64... Is>
+        void relocate_columns(void** columns, std::index_sequence<Is...>);
+        template <u64... Is>
+        void destroy_range(u64 from, u64 to, std::index_sequence<Is...>);
+        template <u64... Is>
+        void construct_at(u64 index, std::index_sequence<Is...>, Ts&&... values);
+        template <u64... Is>
+        void construct_default(u64 from, u64 to, std::index_sequence<Is...>);
+        template <u64... Is>
+        void move_element(u64 from, u64 to, std::index_sequence<Is...>);
+
+        void grow(u64 capacity);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void grow(cstr file, u32 line, u64 capacity);
+#endif
+
+        void* m_block;
+        void* m_columns[column_count];
+        u64 m_length;
+        u64 m_capacity;
+        mem::Allocator* m_allocator;
+        bool m_own_allocator;
+    };
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    soa_dyarr<Ts...>::soa_dyarr()
+        : m_block{nullptr},
+          m_columns{},
+          m_length{0},
+          m_capacity{0},
+          m_allocator{nullptr},
+          m_own_allocator{false} {}
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    soa_dyarr<Ts...>::soa_dyarr(soa_dyarr&& other)
+        : m_block{other.m_block},
+          m_length{other.m_length},
+          m_capacity{other.m_capacity},
+          m_allocator{other.m_allocator},
+          m_own_allocator{other.m_own_allocator} {
+        std::memcpy(m_columns, other.m_columns, sizeof(m_columns));
+        other.soa_dyarr_reset();
+    }
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    soa_dyarr<Ts...>& soa_dyarr<Ts...>::operator=(soa_dyarr&& other) {
+        m_block = other.m_block;
+        std::memcpy(m_columns, other.m_columns, sizeof(m_columns));
+        m_length = other.m_length;
+        m_capacity = other.m_capacity;
+        m_allocator = other.m_allocator;
+        m_own_allocator = other.m_own_allocator;
+
+        other.soa_dyarr_reset();
+
+        return *this;
+    }
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    soa_dyarr<Ts...>::~soa_dyarr() {
+        if (m_allocator != nullptr) {
+            _soa_dyarr_clear();
+            return;
+        }
+        WarnLogIf(m_block != nullptr, "nk::cl::~soa_dyarr not correctly freed.");
+    }
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    void soa_dyarr<Ts...>::_soa_dyarr_init(mem::Allocator* allocator, u64 capacity) {
+        Assert(allocator != nullptr);
+        m_allocator = allocator;
+        grow(capacity);
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    void soa_dyarr<Ts...>::_soa_dyarr_init(cstr file, u32 line, mem::Allocator* allocator, u64 capacity) {
+        Assert(allocator != nullptr);
+        m_allocator = allocator;
+        grow(file, line, capacity);
+    }
+#endif
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    void soa_dyarr<Ts...>::_soa_dyarr_clear() {
+        if (m_block == nullptr)
+            return;
+
+        if (m_allocator == nullptr) {
+            ErrorLog("nk::cl::soa_dyarr::soa_dyarr_clear Trying to clear array with no allocator, initialize.");
+            return;
+        }
+
+        destroy_range(0, m_length, std::index_sequence_for<Ts...>{});
+        m_allocator->free_raw(m_block, block_size(m_capacity));
+
+        m_block = nullptr;
+        std::memset(m_columns, 0, sizeof(m_columns));
+        m_length = 0;
+        m_capacity = 0;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    void soa_dyarr<Ts...>::_soa_dyarr_clear(cstr file, u32 line) {
+        if (m_block == nullptr)
+            return;
+
+        if (m_allocator == nullptr) {
+            ErrorLog("nk::cl::soa_dyarr::soa_dyarr_clear Trying to clear array with no allocator, initialize.");
+            return;
+        }
+
+        destroy_range(0, m_length, std::index_sequence_for<Ts...>{});
+        m_allocator->_free_raw(file, line, m_block, block_size(m_capacity));
+
+        m_block = nullptr;
+        std::memset(m_columns, 0, sizeof(m_columns));
+        m_length = 0;
+        m_capacity = 0;
+    }
+#endif
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    void soa_dyarr<Ts...>::_soa_dyarr_shutdown() {
+        _soa_dyarr_clear();
+
+        if (m_own_allocator)
+            native_deconstruct(mem::Allocator, m_allocator);
+
+        soa_dyarr_reset();
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    void soa_dyarr<Ts...>::_soa_dyarr_shutdown(cstr file, u32 line) {
+        _soa_dyarr_clear(file, line);
+
+        if (m_own_allocator)
+            os::_native_deconstruct<mem::Allocator>(file, line, m_allocator);
+
+        soa_dyarr_reset();
+    }
+#endif
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    void soa_dyarr<Ts...>::_soa_dyarr_reserve(u64 capacity) {
+        if (capacity > m_capacity)
+            grow(capacity);
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    void soa_dyarr<Ts...>::_soa_dyarr_reserve(cstr file, u32 line, u64 capacity) {
+        if (capacity > m_capacity)
+            grow(file, line, capacity);
+    }
+#endif
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    void soa_dyarr<Ts...>::_soa_dyarr_push(Ts... values) {
+        if (m_length >= m_capacity)
+            grow(m_capacity);
+
+        construct_at(m_length, std::index_sequence_for<Ts...>{}, std::move(values)...);
+        m_length++;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    void soa_dyarr<Ts...>::_soa_dyarr_push(cstr file, u32 line, Ts... values) {
+        if (m_length >= m_capacity)
+            grow(file, line, m_capacity);
+
+        construct_at(m_length, std::index_sequence_for<Ts...>{}, std::move(values)...);
+        m_length++;
+    }
+#endif
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    void soa_dyarr<Ts...>::_soa_dyarr_resize(u64 length) {
+        if (length > m_capacity)
+            grow(length);
+
+        if (length > m_length) {
+            construct_default(m_length, length, std::index_sequence_for<Ts...>{});
+        } else {
+            destroy_range(length, m_length, std::index_sequence_for<Ts...>{});
+        }
+        m_length = length;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    void soa_dyarr<Ts...>::_soa_dyarr_resize(cstr file, u32 line, u64 length) {
+        if (length > m_capacity)
+            grow(file, line, length);
+
+        if (length > m_length) {
+            construct_default(m_length, length, std::index_sequence_for<Ts...>{});
+        } else {
+            destroy_range(length, m_length, std::index_sequence_for<Ts...>{});
+        }
+        m_length = length;
+    }
+#endif
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    bool soa_dyarr<Ts...>::soa_dyarr_pop() {
+        if (m_length == 0)
+            return false;
+
+        m_length--;
+        destroy_range(m_length, m_length + 1, std::index_sequence_for<Ts...>{});
+        return true;
+    }
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    bool soa_dyarr<Ts...>::soa_dyarr_remove(u64 index) {
+        if (index >= m_length) {
+            WarnLog("nk::cl::soa_dyarr::remove Index '{}' out of bounds! Length: {}", index, m_length);
+            return false;
+        }
+
+        for (u64 i = index; i + 1 < m_length; i++) {
+            move_element(i + 1, i, std::index_sequence_for<Ts...>{});
+        }
+
+        return soa_dyarr_pop();
+    }
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    bool soa_dyarr<Ts...>::soa_dyarr_swap_remove(u64 index) {
+        if (index >= m_length) {
+            WarnLog("nk::cl::soa_dyarr::swap_remove Index '{}' out of bounds! Length: {}", index, m_length);
+            return false;
+        }
+
+        if (index != m_length - 1)
+            move_element(m_length - 1, index, std::index_sequence_for<Ts...>{});
+
+        return soa_dyarr_pop();
+    }
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    void soa_dyarr<Ts...>::soa_dyarr_reset() {
+        m_block = nullptr;
+        std::memset(m_columns, 0, sizeof(m_columns));
+        m_length = 0;
+        m_capacity = 0;
+        m_allocator = nullptr;
+        m_own_allocator = false;
+    }
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    std::tuple<Ts&...> soa_dyarr<Ts...>::operator[](const u64 index) {
+        Assert(index < m_length);
+        return [&]<u64... Is>(std::index_sequence<Is...>) {
+            return std::tuple<Ts&...>{column<Is>()[index]...};
+        }(std::index_sequence_for<Ts...>{});
+    }
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    std::tuple<const Ts&...> soa_dyarr<Ts...>::operator[](const u64 index) const {
+        Assert(index < m_length);
+        return [&]<u64... Is>(std::index_sequence<Is...>) {
+            return std::tuple<const Ts&...>{column<Is>()[index]...};
+        }(std::index_sequence_for<Ts...>{});
+    }
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    void soa_dyarr<Ts...>::place_columns(void* block, u64 capacity, void** out_columns) const {
+        const uintptr_t base = align_up(reinterpret_cast<uintptr_t>(block));
+        u64 offset = 0;
+        u64 column_index = 0;
+        ((out_columns[column_index++] = reinterpret_cast<void*>(base + align_up(offset)),
+          offset = align_up(offset) + sizeof(Ts) * capacity),
+         ...);
+    }
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    template <u64... Is>
+    void soa_dyarr<Ts...>::relocate_columns(void** columns, std::index_sequence<Is...>) {
+        (mem::realocate_n(column<Is>(), static_cast<column_t<Is>*>(columns[Is]), m_length), ...);
+    }
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    template <u64... Is>
+    void soa_dyarr<Ts...>::destroy_range(u64 from, u64 to, std::index_sequence<Is...>) {
+        if constexpr ((!std::is_trivially_destructible_v<Ts> || ...)) {
+            for (u64 i = from; i < to; i++) {
+                (std::destroy_at(column<Is>() + i), ...);
+            }
+        }
+    }
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    template <u64... Is>
+    void soa_dyarr<Ts...>::construct_at(u64 index, std::index_sequence<Is...>, Ts&&... values) {
+        (std::construct_at(column<Is>() + index, std::move(values)), ...);
+    }
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    template <u64... Is>
+    void soa_dyarr<Ts...>::construct_default(u64 from, u64 to, std::index_sequence<Is...>) {
+        for (u64 i = from; i < to; i++) {
+            (std::construct_at(column<Is>() + i), ...);
+        }
+    }
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    template <u64... Is>
+    void soa_dyarr<Ts...>::move_element(u64 from, u64 to, std::index_sequence<Is...>) {
+        ((column<Is>()[to] = std::move(column<Is>()[from])), ...);
+    }
+
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    void soa_dyarr<Ts...>::grow(u64 capacity) {
+        if (capacity < m_capacity * 2) {
+            capacity = m_capacity * 2;
+        }
+
+        if (capacity < 4) {
+            capacity = 4;
+        }
+
+        void* block = m_allocator->allocate_raw(block_size(capacity), soa_alignment);
+        void* columns[column_count];
+        place_columns(block, capacity, columns);
+
+        if (m_length > 0)
+            relocate_columns(columns, std::index_sequence_for<Ts...>{});
+
+        if (m_block != nullptr)
+            m_allocator->free_raw(m_block, block_size(m_capacity));
+
+        m_block = block;
+        std::memcpy(m_columns, columns, sizeof(m_columns));
+        m_capacity = capacity;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <IArrT... Ts>
+        requires(sizeof...(Ts) > 0)
+    void soa_dyarr<Ts...>::grow(cstr file, u32 line, u64 capacity) {
+        if (capacity < m_capacity * 2) {
+            capacity = m_capacity * 2;
+        }
+
+        if (capacity < 4) {
+            capacity = 4;
+        }
+
+        void* block = m_allocator->_allocate_raw(file, line, block_size(capacity), soa_alignment);
+        void* columns[column_count];
+        place_columns(block, capacity, columns);
+
+        if (m_length > 0)
+            relocate_columns(columns, std::index_sequence_for<Ts...>{});
+
+        if (m_block != nullptr)
+            m_allocator->_free_raw(file, line, m_block, block_size(m_capacity));
+
+        m_block = block;
+        std::memcpy(m_columns, columns, sizeof(m_columns));
+        m_capacity = capacity;
+    }
+#endif
+}
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+
+    #define soa_dyarr_init(allocator, capacity) \
+        _soa_dyarr_init(__FILE__, __LINE__, (allocator), (capacity))
+
+    #define soa_dyarr_clear() \
+        _soa_dyarr_clear(__FILE__, __LINE__)
+
+    #define soa_dyarr_shutdown() \
+        _soa_dyarr_shutdown(__FILE__, __LINE__)
+
+    #define soa_dyarr_reserve(capacity) \
+        _soa_dyarr_reserve(__FILE__, __LINE__, (capacity))
+
+    #define soa_dyarr_push(...) \
+        _soa_dyarr_push(__FILE__, __LINE__, __VA_ARGS__)
+
+    #define soa_dyarr_resize(length) \
+        _soa_dyarr_resize(__FILE__, __LINE__, (length))
+
+#else
+
+    #define soa_dyarr_init(allocator, capacity) \
+        _soa_dyarr_init((allocator), (capacity))
+
+    #define soa_dyarr_clear() \
+        _soa_dyarr_clear()
+
+    #define soa_dyarr_shutdown() \
+        _soa_dyarr_shutdown()
+
+    #define soa_dyarr_reserve(capacity) \
+        _soa_dyarr_reserve((capacity))
+
+    #define soa_dyarr_push(...) \
+        _soa_dyarr_push(__VA_ARGS__)
+
+    #define soa_dyarr_resize(length) \
+        _soa_dyarr_resize((length))
+
+#endif
@@ -0,0 +1,377 @@
+#pragma once
+
+#include "memory/allocator.h"
+
+namespace nk::cl {
+    template <typename K>
+    concept RadixKey = (std::is_integral_v<K> || std::is_floating_point_v<K>) && !std::is_same_v<K, bool> &&
+                       (sizeof(K) == 4 || sizeof(K) == 8);
+
+    namespace radix {
+        static constexpr u64 digit_bits = 8;
+        static constexpr u64 digit_count = 1 << digit_bits;
+        static constexpr u64 digit_mask = digit_count - 1;
+
+        // Inputs smaller than this are sorted on the calling thread by the parallel variants.
+        static constexpr u64 parallel_threshold = 1 << 16;
+        static constexpr u64 max_threads = 64;
+
+        template <RadixKey K>
+        using bits_t = std::conditional_t<sizeof(K) == 4, u32, u64>;
+
+        // Maps a key to an unsigned integer that sorts in the same order. Negative
+        // floats have all bits flipped, positive floats and signed integers get
+        // their sign bit flipped.
+        template <RadixKey K>
+        constexpr bits_t<K> to_bits(K key) {
+            using B = bits_t<K>;
+            constexpr B sign = B{1} << (sizeof(B) * 8 - 1);
+
+            const B bits = std::bit_cast<B>(key);
+            if constexpr (std::is_floating_point_v<K>) {
+                return (bits & sign) ? ~bits : (bits | sign);
+            } else if constexpr (std::is_signed_v<K>) {
+                return bits ^ sign;
+            } else {
+                return bits;
+            }
+        }
+
+        template <RadixKey K>
+        constexpr u64 digit(K key, u64 pass) {
+            return (to_bits(key) >> (pass * digit_bits)) & digit_mask;
+        }
+
+        struct NoValue {};
+
+        // Stable LSD sort of keys (and values when V is not NoValue) using the
+        // scratch buffers, which need the same length as the input. Passes where
+        // every key shares the same digit are skipped.
+        template <RadixKey K, typename V>
+        void sort(K* keys, V* values, u64 count, K* scratch_keys, V* scratch_values) {
+            constexpr bool has_values = !std::is_same_v<V, NoValue>;
+            constexpr u64 pass_count = sizeof(K);
+
+            if (count < 2)
+                return;
+
+            u64 histogram[pass_count][digit_count] = {};
+            for (u64 i = 0; i < count; i++) {
+                const auto bits = to_bits(keys[i]);
+                for (u64 pass = 0; pass < pass_count; pass++) {
+                    histogram[pass][(bits >> (pass * digit_bits)) & digit_mask]++;
+                }
+            }
+
+            K* src_keys = keys;
+            K* dst_keys = scratch_keys;
+            V* src_values = values;
+            V* dst_values = scratch_values;
+
+            for (u64 pass = 0; pass < pass_count; pass++) {
+                u64* counts = histogram[pass];
+                if (counts[digit(src_keys[0], pass)] == count)
+                    continue;
+
+                u64 offset = 0;
+                for (u64 d = 0; d < digit_count; d++) {
+                    const u64 digit_total = counts[d];
+                    counts[d] = offset;
+                    offset += digit_total;
+                }
+
+                for (u64 i = 0; i < count; i++) {
+                    const u64 destination = counts[digit(src_keys[i], pass)]++;
+                    dst_keys[destination] = src_keys[i];
+                    if constexpr (has_values) {
+                        dst_values[destination] = src_values[i];
+                    }
+                }
+
+                std::swap(src_keys, dst_keys);
+                if constexpr (has_values) {
+                    std::swap(src_values, dst_values);
+                }
+            }
+
+            if (src_keys != keys) {
+                std::memcpy(keys, src_keys, sizeof(K) * count);
+                if constexpr (has_values) {
+                    std::memcpy(values, src_values, sizeof(V) * count);
+                }
+            }
+        }
+
+        // Same result as sort but every pass is split in contiguous chunks, one
+        // per thread. Threads build chunk histograms, a barrier turns them into
+        // per-thread scatter offsets, then every thread scatters its chunk,
+        // which keeps the sort stable.
+        template <RadixKey K, typename V>
+        void sort_parallel(K* keys, V* values, u64 count, K* scratch_keys, V* scratch_values,
+                           u64* offsets, u64 thread_count) {
+            constexpr bool has_values = !std::is_same_v<V, NoValue>;
+            constexpr u64 pass_count = sizeof(K);
+
+            struct State {
+                K* src_keys;
+                K* dst_keys;
+                V* src_values;
+                V* dst_values;
+                u64 pass;
+                bool skip;
+            };
+
+            State state = {
+                .src_keys = keys,
+                .dst_keys = scratch_keys,
+                .src_values = values,
+                .dst_values = scratch_values,
+                .pass = 0,
+                .skip = false,
+            };
+
+            auto on_histograms = [&]() noexcept {
+                u64 offset = 0;
+                state.skip = false;
+                for (u64 d = 0; d < digit_count; d++) {
+                    u64 digit_total = 0;
+                    for (u64 t = 0; t < thread_count; t++) {
+                        const u64 thread_total = offsets[t * digit_count + d];
+                        offsets[t * digit_count + d] = offset + digit_total;
+                        digit_total += thread_total;
+                    }
+                    state.skip |= digit_total == count;
+                    offset += digit_total;
+                }
+            };
+
+            auto on_scatter = [&]() noexcept {
+                if (!state.skip) {
+                    std::swap(state.src_keys, state.dst_keys);
+                    if constexpr (has_values) {
+                        std::swap(state.src_values, state.dst_values);
+                    }
+                }
+                state.pass++;
+            };
+
+            std::barrier histogram_barrier(static_cast<std::ptrdiff_t>(thread_count), on_histograms);
+            std::barrier scatter_barrier(static_cast<std::ptrdiff_t>(thread_count), on_scatter);
+
+            const u64 chunk = (count + thread_count - 1) / thread_count;
+            auto worker = [&](u64 thread_index) {
+                const u64 begin = MinValue(thread_index * chunk, count);
+                const u64 end = MinValue(begin + chunk, count);
+                u64* thread_offsets = offsets + thread_index * digit_count;
+
+                for (u64 pass = 0; pass < pass_count; pass++) {
+                    std::memset(thread_offsets, 0, sizeof(u64) * digit_count);
+                    for (u64 i = begin; i < end; i++) {
+                        thread_offsets[digit(state.src_keys[i], pass)]++;
+                    }
+
+                    histogram_barrier.arrive_and_wait();
+
+                    if (!state.skip) {
+                        for (u64 i = begin; i < end; i++) {
+                            const u64 destination = thread_offsets[digit(state.src_keys[i], pass)]++;
+                            state.dst_keys[destination] = state.src_keys[i];
+                            if constexpr (has_values) {
+                                state.dst_values[destination] = state.src_values[i];
+                            }
+                        }
+                    }
+
+                    scatter_barrier.arrive_and_wait();
+                }
+            };
+
+            std::thread threads[max_threads];
+            for (u64 t = 1; t < thread_count; t++) {
+                threads[t] = std::thread(worker, t);
+            }
+            worker(0);
+            for (u64 t = 1; t < thread_count; t++) {
+                threads[t].join();
+            }
+
+            if (state.src_keys != keys) {
+                std::memcpy(keys, state.src_keys, sizeof(K) * count);
+                if constexpr (has_values) {
+                    std::memcpy(values, state.src_values, sizeof(V) * count);
+                }
+            }
+        }
+
+        inline u64 thread_count_for(u64 count, u64 thread_count) {
+            if (thread_count == 0)
+                thread_count = MaxValue(std::thread::hardware_concurrency(), 1u);
+
+            const u64 useful = MaxValue(count / parallel_threshold, u64{1});
+            return MinValue(MinValue(thread_count, useful), max_threads);
+        }
+    }
+
+    // Sorts using caller provided scratch buffers of the same length, never allocates.
+    template <RadixKey K>
+    void radix_sort_scratch(K* keys, u64 count, K* scratch_keys) {
+        radix::sort<K, radix::NoValue>(keys, nullptr, count, scratch_keys, nullptr);
+    }
+
+    template <RadixKey K, typename V>
+        requires std::is_trivially_copyable_v<V>
+    void radix_sort_pairs_scratch(K* keys, V* values, u64 count, K* scratch_keys, V* scratch_values) {
+        radix::sort<K, V>(keys, values, count, scratch_keys, scratch_values);
+    }
+
+    template <RadixKey K>
+    void _radix_sort(mem::Allocator* allocator, K* keys, u64 count) {
+        if (count < 2)
+            return;
+
+        K* scratch_keys = allocator->allocate_lot_t(K, count);
+        radix::sort<K, radix::NoValue>(keys, nullptr, count, scratch_keys, nullptr);
+        allocator->free_lot_t(K, scratch_keys, count);
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <RadixKey K>
+    void _radix_sort(cstr file, u32 line, mem::Allocator* allocator, K* keys, u64 count) {
+        if (count < 2)
+            return;
+
+        K* scratch_keys = allocator->_allocate_lot_t<K>(file, line, count);
+        radix::sort<K, radix::NoValue>(keys, nullptr, count, scratch_keys, nullptr);
+        allocator->_free_lot_t<K>(file, line, scratch_keys, count);
+    }
+#endif
+
+    template <RadixKey K, typename V>
+        requires std::is_trivially_copyable_v<V>
+    void _radix_sort_pairs(mem::Allocator* allocator, K* keys, V* values, u64 count) {
+        if (count < 2)
+            return;
+
+        K* scratch_keys = allocator->allocate_lot_t(K, count);
+        V* scratch_values = allocator->allocate_lot_t(V, count);
+        radix::sort<K, V>(keys, values, count, scratch_keys, scratch_values);
+        allocator->free_lot_t(V, scratch_values, count);
+        allocator->free_lot_t(K, scratch_keys, count);
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <RadixKey K, typename V>
+        requires std::is_trivially_copyable_v<V>
+    void _radix_sort_pairs(cstr file, u32 line, mem::Allocator* allocator, K* keys, V* values, u64 count) {
+        if (count < 2)
+            return;
+
+        K* scratch_keys = allocator->_allocate_lot_t<K>(file, line, count);
+        V* scratch_values = allocator->_allocate_lot_t<V>(file, line, count);
+        radix::sort<K, V>(keys, values, count, scratch_keys, scratch_values);
+        allocator->_free_lot_t<V>(file, line, scratch_values, count);
+        allocator->_free_lot_t<K>(file, line, scratch_keys, count);
+    }
+#endif
+
+    // thread_count == 0 uses every hardware thread. Small inputs stay single threaded.
+    template <RadixKey K>
+    void _radix_sort_parallel(mem::Allocator* allocator, K* keys, u64 count, u64 thread_count = 0) {
+        thread_count = radix::thread_count_for(count, thread_count);
+        if (thread_count <= 1) {
+            _radix_sort(allocator, keys, count);
+            return;
+        }
+
+        K* scratch_keys = allocator->allocate_lot_t(K, count);
+        u64* offsets = allocator->allocate_lot_t(u64, thread_count * radix::digit_count);
+        radix::sort_parallel<K, radix::NoValue>(keys, nullptr, count, scratch_keys, nullptr, offsets, thread_count);
+        allocator->free_lot_t(u64, offsets, thread_count * radix::digit_count);
+        allocator->free_lot_t(K, scratch_keys, count);
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <RadixKey K>
+    void _radix_sort_parallel(cstr file, u32 line, mem::Allocator* allocator, K* keys, u64 count, u64 thread_count = 0) {
+        thread_count = radix::thread_count_for(count, thread_count);
+        if (thread_count <= 1) {
+            _radix_sort(file, line, allocator, keys, count);
+            return;
+        }
+
+        K* scratch_keys = allocator->_allocate_lot_t<K>(file, line, count);
+        u64* offsets = allocator->_allocate_lot_t<u64>(file, line, thread_count * radix::digit_count);
+        radix::sort_parallel<K, radix::NoValue>(keys, nullptr, count, scratch_keys, nullptr, offsets, thread_count);
+        allocator->_free_lot_t<u64>(file, line, offsets, thread_count * radix::digit_count);
+        allocator->_free_lot_t<K>(file, line, scratch_keys, count);
+    }
+#endif
+
+    template <RadixKey K, typename V>
+        requires std::is_trivially_copyable_v<V>
+    void _radix_sort_pairs_parallel(mem::Allocator* allocator, K* keys, V* values, u64 count, u64 thread_count = 0) {
+        thread_count = radix::thread_count_for(count, thread_count);
+        if (thread_count <= 1) {
+            _radix_sort_pairs(allocator, keys, values, count);
+            return;
+        }
+
+        K* scratch_keys = allocator->allocate_lot_t(K, count);
+        V* scratch_values = allocator->allocate_lot_t(V, count);
+        u64* offsets = allocator->allocate_lot_t(u64, thread_count * radix::digit_count);
+        radix::sort_parallel<K, V>(keys, values, count, scratch_keys, scratch_values, offsets, thread_count);
+        allocator->free_lot_t(u64, offsets, thread_count * radix::digit_count);
+        allocator->free_lot_t(V, scratch_values, count);
+        allocator->free_lot_t(K, scratch_keys, count);
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <RadixKey K, typename V>
+        requires std::is_trivially_copyable_v<V>
+    void _radix_sort_pairs_parallel(cstr file, u32 line, mem::Allocator* allocator, K* keys, V* values, u64 count, u64 thread_count = 0) {
+        thread_count = radix::thread_count_for(count, thread_count);
+        if (thread_count <= 1) {
+            _radix_sort_pairs(file, line, allocator, keys, values, count);
+            return;
+        }
+
+        K* scratch_keys = allocator->_allocate_lot_t<K>(file, line, count);
+        V* scratch_values = allocator->_allocate_lot_t<V>(file, line, count);
+        u64* offsets = allocator->_allocate_lot_t<u64>(file, line, thread_count * radix::digit_count);
+        radix::sort_parallel<K, V>(keys, values, count, scratch_keys, scratch_values, offsets, thread_count);
+        allocator->_free_lot_t<u64>(file, line, offsets, thread_count * radix::digit_count);
+        allocator->_free_lot_t<V>(file, line, scratch_values, count);
+        allocator->_free_lot_t<K>(file, line, scratch_keys, count);
+    }
+#endif
+}
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+
+    #define radix_sort(allocator, ...) \
+        _radix_sort(__FILE__, __LINE__, (allocator), __VA_ARGS__)
+
+    #define radix_sort_pairs(allocator, ...) \
+        _radix_sort_pairs(__FILE__, __LINE__, (allocator), __VA_ARGS__)
+
+    #define radix_sort_parallel(allocator, ...) \
+        _radix_sort_parallel(__FILE__, __LINE__, (allocator), __VA_ARGS__)
+
+    #define radix_sort_pairs_parallel(allocator, ...) \
+        _radix_sort_pairs_parallel(__FILE__, __LINE__, (allocator), __VA_ARGS__)
+
+#else
+
+    #define radix_sort(allocator, ...) \
+        _radix_sort((allocator), __VA_ARGS__)
+
+    #define radix_sort_pairs(allocator, ...) \
+        _radix_sort_pairs((allocator), __VA_ARGS__)
+
+    #define radix_sort_parallel(allocator, ...) \
+        _radix_sort_parallel((allocator), __VA_ARGS__)
+
+    #define radix_sort_pairs_parallel(allocator, ...) \
+        _radix_sort_pairs_parallel((allocator), __VA_ARGS__)
+
+#endif
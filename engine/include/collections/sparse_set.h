@@ -0,0 +1,670 @@
+#pragma once
+
+#include "memory/allocator.h"
+#include "collections/arr_type.h"
+
+namespace nk::cl {
+    // Set of integer ids with O(1) insert, remove and contains. Ids live packed
+    // in a dense array, so iterating costs proportional to the set length and
+    // not to the largest id. The sparse index maps an id to its dense slot and
+    // is split in pages that are only allocated once an id in their range is
+    // inserted. When V is not void every id carries a value stored in a
+    // parallel dense array. Removing swaps the last element in, so dense order
+    // is not stable.
+    template <std::unsigned_integral Id = u32, typename V = void, u64 PageSize = 4096>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    class sparse_set {
+    public:
+        static constexpr bool has_values = !std::is_void_v<V>;
+        static constexpr u64 page_size = PageSize;
+        static constexpr u64 page_shift = std::countr_zero(PageSize);
+        static constexpr u64 page_mask = PageSize - 1;
+        // All bits set, so fresh sparse pages are filled with memset.
+        static constexpr Id null_index = std::numeric_limits<Id>::max();
+
+        using value_t = std::conditional_t<has_values, V, u8>;
+
+        sparse_set();
+
+        sparse_set(sparse_set&& other);
+        sparse_set& operator=(sparse_set&& other);
+
+        sparse_set(const sparse_set&) = delete;
+        sparse_set& operator=(const sparse_set&) = delete;
+
+        ~sparse_set();
+
+        void _sparse_set_init(mem::Allocator* allocator, u64 capacity);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _sparse_set_init(cstr file, u32 line, mem::Allocator* allocator, u64 capacity);
+#endif
+
+        void _sparse_set_init_own(mem::Allocator* allocator, u64 capacity);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _sparse_set_init_own(cstr file, u32 line, mem::Allocator* allocator, u64 capacity);
+#endif
+
+        void _sparse_set_clear();
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _sparse_set_clear(cstr file, u32 line);
+#endif
+
+        void _sparse_set_shutdown();
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _sparse_set_shutdown(cstr file, u32 line);
+#endif
+
+        void _sparse_set_reserve(u64 capacity);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void _sparse_set_reserve(cstr file, u32 line, u64 capacity);
+#endif
+
+        // Returns false if the id was already in the set.
+        bool _sparse_set_insert(Id id)
+            requires(!has_values);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        bool _sparse_set_insert(cstr file, u32 line, Id id)
+            requires(!has_values);
+#endif
+
+        // Overwrites the value if the id was already in the set.
+        value_t& _sparse_set_insert(Id id, value_t value)
+            requires(has_values);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        value_t& _sparse_set_insert(cstr file, u32 line, Id id, value_t value)
+            requires(has_values);
+#endif
+
+        bool sparse_set_remove(Id id);
+
+        // Removes every id but keeps the sparse pages and dense storage.
+        void sparse_set_reset();
+
+        bool contains(Id id) const { return index_of(id) != null_index; }
+
+        // Dense slot of the id, null_index if the id is not in the set.
+        Id index_of(Id id) const;
+
+        value_t* get(Id id)
+            requires(has_values);
+
+        Id* begin() { return m_dense; }
+        Id* end() { return m_dense + m_length; }
+        const Id* begin() const { return m_dense; }
+        const Id* end() const { return m_dense + m_length; }
+
+        Id* data() { return m_dense; }
+        const Id* data() const { return m_dense; }
+        value_t* values()
+            requires(has_values)
+        {
+            return m_values;
+        }
+
+        u64 length() const { return m_length; }
+        u64 capacity() const { return m_capacity; }
+        bool empty() const { return m_length == 0; }
+        mem::Allocator* allocator() { return m_allocator; }
+        bool owns_allocator() const { return m_own_allocator; }
+
+    private:
+        Id* sparse_slot(Id id) const;
+
+        Id& ensure_sparse_slot(Id id);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        Id& ensure_sparse_slot(cstr file, u32 line, Id id);
+#endif
+
+        void grow(u64 capacity);
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+        void grow(cstr file, u32 line, u64 capacity);
+#endif
+
+        void relocate(Id* dense, value_t* values);
+
+        Id** m_sparse;
+        u64 m_sparse_page_count;
+        Id* m_dense;
+        value_t* m_values;
+        u64 m_length;
+        u64 m_capacity;
+        mem::Allocator* m_allocator;
+        bool m_own_allocator;
+    };
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    sparse_set<Id, V, PageSize>::sparse_set()
+        : m_sparse{nullptr},
+          m_sparse_page_count{0},
+          m_dense{nullptr},
+          m_values{nullptr},
+          m_length{0},
+          m_capacity{0},
+          m_allocator{nullptr},
+          m_own_allocator{false} {}
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    sparse_set<Id, V, PageSize>::sparse_set(sparse_set&& other)
+        : m_sparse{other.m_sparse},
+          m_sparse_page_count{other.m_sparse_page_count},
+          m_dense{other.m_dense},
+          m_values{other.m_values},
+          m_length{other.m_length},
+          m_capacity{other.m_capacity},
+          m_allocator{other.m_allocator},
+          m_own_allocator{other.m_own_allocator} {
+        other.m_sparse = nullptr;
+        other.m_sparse_page_count = 0;
+        other.m_dense = nullptr;
+        other.m_values = nullptr;
+        other.m_length = 0;
+        other.m_capacity = 0;
+        other.m_allocator = nullptr;
+        other.m_own_allocator = false;
+    }
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    sparse_set<Id, V, PageSize>& sparse_set<Id, V, PageSize>::operator=(sparse_set&& other) {
+        m_sparse = other.m_sparse;
+        m_sparse_page_count = other.m_sparse_page_count;
+        m_dense = other.m_dense;
+        m_values = other.m_values;
+        m_length = other.m_length;
+        m_capacity = other.m_capacity;
+        m_allocator = other.m_allocator;
+        m_own_allocator = other.m_own_allocator;
+
+        other.m_sparse = nullptr;
+        other.m_sparse_page_count = 0;
+        other.m_dense = nullptr;
+        other.m_values = nullptr;
+        other.m_length = 0;
+        other.m_capacity = 0;
+        other.m_allocator = nullptr;
+        other.m_own_allocator = false;
+
+        return *this;
+    }
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    sparse_set<Id, V, PageSize>::~sparse_set() {
+        if (m_allocator != nullptr) {
+            _sparse_set_clear();
+            return;
+        }
+        WarnLogIf(m_dense != nullptr || m_sparse != nullptr, "nk::cl::~sparse_set not correctly freed.");
+    }
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void sparse_set<Id, V, PageSize>::_sparse_set_init(mem::Allocator* allocator, u64 capacity) {
+        Assert(allocator != nullptr);
+        m_allocator = allocator;
+        if (capacity > 0)
+            grow(capacity);
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void sparse_set<Id, V, PageSize>::_sparse_set_init(cstr file, u32 line, mem::Allocator* allocator, u64 capacity) {
+        Assert(allocator != nullptr);
+        m_allocator = allocator;
+        if (capacity > 0)
+            grow(file, line, capacity);
+    }
+#endif
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void sparse_set<Id, V, PageSize>::_sparse_set_init_own(mem::Allocator* allocator, u64 capacity) {
+        _sparse_set_init(allocator, capacity);
+        m_own_allocator = true;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void sparse_set<Id, V, PageSize>::_sparse_set_init_own(cstr file, u32 line, mem::Allocator* allocator, u64 capacity) {
+        _sparse_set_init(file, line, allocator, capacity);
+        m_own_allocator = true;
+    }
+#endif
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void sparse_set<Id, V, PageSize>::_sparse_set_clear() {
+        if (m_dense == nullptr && m_sparse == nullptr)
+            return;
+
+        if (m_allocator == nullptr) {
+            ErrorLog("nk::cl::sparse_set::sparse_set_clear Trying to clear set with no allocator, initialize.");
+            return;
+        }
+
+        if constexpr (has_values && !std::is_trivially_destructible_v<value_t>) {
+            std::destroy_n(m_values, m_length);
+        }
+
+        for (u64 i = 0; i < m_sparse_page_count; i++) {
+            if (m_sparse[i] != nullptr)
+                m_allocator->free_lot_t(Id, m_sparse[i], PageSize);
+        }
+        if (m_sparse != nullptr)
+            m_allocator->free_lot_t(Id*, m_sparse, m_sparse_page_count);
+
+        if (m_dense != nullptr) {
+            m_allocator->free_lot_t(Id, m_dense, m_capacity);
+            if constexpr (has_values) {
+                m_allocator->free_lot_t(value_t, m_values, m_capacity);
+            }
+        }
+
+        m_sparse = nullptr;
+        m_sparse_page_count = 0;
+        m_dense = nullptr;
+        m_values = nullptr;
+        m_length = 0;
+        m_capacity = 0;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void sparse_set<Id, V, PageSize>::_sparse_set_clear(cstr file, u32 line) {
+        if (m_dense == nullptr && m_sparse == nullptr)
+            return;
+
+        if (m_allocator == nullptr) {
+            ErrorLog("nk::cl::sparse_set::sparse_set_clear Trying to clear set with no allocator, initialize.");
+            return;
+        }
+
+        if constexpr (has_values && !std::is_trivially_destructible_v<value_t>) {
+            std::destroy_n(m_values, m_length);
+        }
+
+        for (u64 i = 0; i < m_sparse_page_count; i++) {
+            if (m_sparse[i] != nullptr)
+                m_allocator->_free_lot_t<Id>(file, line, m_sparse[i], PageSize);
+        }
+        if (m_sparse != nullptr)
+            m_allocator->_free_lot_t<Id*>(file, line, m_sparse, m_sparse_page_count);
+
+        if (m_dense != nullptr) {
+            m_allocator->_free_lot_t<Id>(file, line, m_dense, m_capacity);
+            if constexpr (has_values) {
+                m_allocator->_free_lot_t<value_t>(file, line, m_values, m_capacity);
+            }
+        }
+
+        m_sparse = nullptr;
+        m_sparse_page_count = 0;
+        m_dense = nullptr;
+        m_values = nullptr;
+        m_length = 0;
+        m_capacity = 0;
+    }
+#endif
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void sparse_set<Id, V, PageSize>::_sparse_set_shutdown() {
+        _sparse_set_clear();
+
+        if (m_own_allocator)
+            native_deconstruct(mem::Allocator, m_allocator);
+
+        m_allocator = nullptr;
+        m_own_allocator = false;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void sparse_set<Id, V, PageSize>::_sparse_set_shutdown(cstr file, u32 line) {
+        _sparse_set_clear(file, line);
+
+        if (m_own_allocator)
+            os::_native_deconstruct<mem::Allocator>(file, line, m_allocator);
+
+        m_allocator = nullptr;
+        m_own_allocator = false;
+    }
+#endif
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void sparse_set<Id, V, PageSize>::_sparse_set_reserve(u64 capacity) {
+        if (capacity > m_capacity)
+            grow(capacity);
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void sparse_set<Id, V, PageSize>::_sparse_set_reserve(cstr file, u32 line, u64 capacity) {
+        if (capacity > m_capacity)
+            grow(file, line, capacity);
+    }
+#endif
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    bool sparse_set<Id, V, PageSize>::_sparse_set_insert(Id id)
+        requires(!has_values)
+    {
+        Assert(id != null_index, "nk::cl::sparse_set::sparse_set_insert Id {} is reserved.", id);
+
+        Id& slot = ensure_sparse_slot(id);
+        if (slot != null_index)
+            return false;
+
+        if (m_length >= m_capacity)
+            grow(m_capacity == 0 ? 8 : m_capacity * 2);
+
+        slot = static_cast<Id>(m_length);
+        m_dense[m_length++] = id;
+        return true;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    bool sparse_set<Id, V, PageSize>::_sparse_set_insert(cstr file, u32 line, Id id)
+        requires(!has_values)
+    {
+        Assert(id != null_index, "nk::cl::sparse_set::sparse_set_insert Id {} is reserved.", id);
+
+        Id& slot = ensure_sparse_slot(file, line, id);
+        if (slot != null_index)
+            return false;
+
+        if (m_length >= m_capacity)
+            grow(file, line, m_capacity == 0 ? 8 : m_capacity * 2);
+
+        slot = static_cast<Id>(m_length);
+        m_dense[m_length++] = id;
+        return true;
+    }
+#endif
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    typename sparse_set<Id, V, PageSize>::value_t& sparse_set<Id, V, PageSize>::_sparse_set_insert(Id id, value_t value)
+        requires(has_values)
+    {
+        Assert(id != null_index, "nk::cl::sparse_set::sparse_set_insert Id {} is reserved.", id);
+
+        Id& slot = ensure_sparse_slot(id);
+        if (slot != null_index) {
+            m_values[slot] = std::move(value);
+            return m_values[slot];
+        }
+
+        if (m_length >= m_capacity)
+            grow(m_capacity == 0 ? 8 : m_capacity * 2);
+
+        slot = static_cast<Id>(m_length);
+        m_dense[m_length] = id;
+        value_t* stored = std::construct_at(m_values + m_length, std::move(value));
+        m_length++;
+        return *stored;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    typename sparse_set<Id, V, PageSize>::value_t& sparse_set<Id, V, PageSize>::_sparse_set_insert(cstr file, u32 line, Id id, value_t value)
+        requires(has_values)
+    {
+        Assert(id != null_index, "nk::cl::sparse_set::sparse_set_insert Id {} is reserved.", id);
+
+        Id& slot = ensure_sparse_slot(file, line, id);
+        if (slot != null_index) {
+            m_values[slot] = std::move(value);
+            return m_values[slot];
+        }
+
+        if (m_length >= m_capacity)
+            grow(file, line, m_capacity == 0 ? 8 : m_capacity * 2);
+
+        slot = static_cast<Id>(m_length);
+        m_dense[m_length] = id;
+        value_t* stored = std::construct_at(m_values + m_length, std::move(value));
+        m_length++;
+        return *stored;
+    }
+#endif
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    bool sparse_set<Id, V, PageSize>::sparse_set_remove(Id id) {
+        Id* slot = sparse_slot(id);
+        if (slot == nullptr || *slot == null_index)
+            return false;
+
+        const u64 index = *slot;
+        const u64 last = m_length - 1;
+        if (index != last) {
+            const Id moved = m_dense[last];
+            m_dense[index] = moved;
+            *sparse_slot(moved) = static_cast<Id>(index);
+            if constexpr (has_values) {
+                m_values[index] = std::move(m_values[last]);
+            }
+        }
+
+        if constexpr (has_values) {
+            std::destroy_at(m_values + last);
+        }
+
+        *slot = null_index;
+        m_length--;
+        return true;
+    }
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void sparse_set<Id, V, PageSize>::sparse_set_reset() {
+        for (u64 i = 0; i < m_length; i++) {
+            *sparse_slot(m_dense[i]) = null_index;
+        }
+
+        if constexpr (has_values && !std::is_trivially_destructible_v<value_t>) {
+            std::destroy_n(m_values, m_length);
+        }
+
+        m_length = 0;
+    }
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    Id sparse_set<Id, V, PageSize>::index_of(Id id) const {
+        const Id* slot = sparse_slot(id);
+        return slot == nullptr ? null_index : *slot;
+    }
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    typename sparse_set<Id, V, PageSize>::value_t* sparse_set<Id, V, PageSize>::get(Id id)
+        requires(has_values)
+    {
+        const Id index = index_of(id);
+        return index == null_index ? nullptr : m_values + index;
+    }
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    Id* sparse_set<Id, V, PageSize>::sparse_slot(Id id) const {
+        const u64 page = static_cast<u64>(id) >> page_shift;
+        if (page >= m_sparse_page_count || m_sparse[page] == nullptr)
+            return nullptr;
+
+        return &m_sparse[page][id & page_mask];
+    }
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    Id& sparse_set<Id, V, PageSize>::ensure_sparse_slot(Id id) {
+        const u64 page = static_cast<u64>(id) >> page_shift;
+        if (page >= m_sparse_page_count) {
+            const u64 page_count = MaxValue(page + 1, m_sparse_page_count * 2);
+            Id** sparse = m_allocator->allocate_lot_t(Id*, page_count);
+            if (m_sparse != nullptr) {
+                std::memcpy(sparse, m_sparse, sizeof(Id*) * m_sparse_page_count);
+                m_allocator->free_lot_t(Id*, m_sparse, m_sparse_page_count);
+            }
+            std::memset(sparse + m_sparse_page_count, 0, sizeof(Id*) * (page_count - m_sparse_page_count));
+
+            m_sparse = sparse;
+            m_sparse_page_count = page_count;
+        }
+
+        if (m_sparse[page] == nullptr) {
+            m_sparse[page] = m_allocator->allocate_lot_t(Id, PageSize);
+            std::memset(m_sparse[page], 0xFF, sizeof(Id) * PageSize);
+        }
+
+        return m_sparse[page][id & page_mask];
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    Id& sparse_set<Id, V, PageSize>::ensure_sparse_slot(cstr file, u32 line, Id id) {
+        const u64 page = static_cast<u64>(id) >> page_shift;
+        if (page >= m_sparse_page_count) {
+            const u64 page_count = MaxValue(page + 1, m_sparse_page_count * 2);
+            Id** sparse = m_allocator->_allocate_lot_t<Id*>(file, line, page_count);
+            if (m_sparse != nullptr) {
+                std::memcpy(sparse, m_sparse, sizeof(Id*) * m_sparse_page_count);
+                m_allocator->_free_lot_t<Id*>(file, line, m_sparse, m_sparse_page_count);
+            }
+            std::memset(sparse + m_sparse_page_count, 0, sizeof(Id*) * (page_count - m_sparse_page_count));
+
+            m_sparse = sparse;
+            m_sparse_page_count = page_count;
+        }
+
+        if (m_sparse[page] == nullptr) {
+            m_sparse[page] = m_allocator->_allocate_lot_t<Id>(file, line, PageSize);
+            std::memset(m_sparse[page], 0xFF, sizeof(Id) * PageSize);
+        }
+
+        return m_sparse[page][id & page_mask];
+    }
+#endif
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void sparse_set<Id, V, PageSize>::grow(u64 capacity) {
+        Id* dense = m_allocator->allocate_lot_t(Id, capacity);
+        value_t* values = nullptr;
+        if constexpr (has_values) {
+            values = m_allocator->allocate_lot_t(value_t, capacity);
+        }
+
+        relocate(dense, values);
+
+        if (m_dense != nullptr) {
+            m_allocator->free_lot_t(Id, m_dense, m_capacity);
+            if constexpr (has_values) {
+                m_allocator->free_lot_t(value_t, m_values, m_capacity);
+            }
+        }
+
+        m_dense = dense;
+        m_values = values;
+        m_capacity = capacity;
+    }
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void sparse_set<Id, V, PageSize>::grow(cstr file, u32 line, u64 capacity) {
+        Id* dense = m_allocator->_allocate_lot_t<Id>(file, line, capacity);
+        value_t* values = nullptr;
+        if constexpr (has_values) {
+            values = m_allocator->_allocate_lot_t<value_t>(file, line, capacity);
+        }
+
+        relocate(dense, values);
+
+        if (m_dense != nullptr) {
+            m_allocator->_free_lot_t<Id>(file, line, m_dense, m_capacity);
+            if constexpr (has_values) {
+                m_allocator->_free_lot_t<value_t>(file, line, m_values, m_capacity);
+            }
+        }
+
+        m_dense = dense;
+        m_values = values;
+        m_capacity = capacity;
+    }
+#endif
+
+    template <std::unsigned_integral Id, typename V, u64 PageSize>
+        requires(PageSize > 0 && (PageSize & (PageSize - 1)) == 0)
+    void sparse_set<Id, V, PageSize>::relocate(Id* dense, value_t* values) {
+        if (m_length == 0)
+            return;
+
+        std::memcpy(dense, m_dense, sizeof(Id) * m_length);
+
+        if constexpr (has_values) {
+            if constexpr (std::is_trivially_copyable_v<value_t>) {
+                std::memcpy(values, m_values, sizeof(value_t) * m_length);
+            } else {
+                std::uninitialized_move_n(m_values, m_length, values);
+                std::destroy_n(m_values, m_length);
+            }
+        }
+    }
+}
+
+#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO && NK_ACTIVE_MEMORY_SYSTEM
+
+    #define sparse_set_init(allocator, capacity) \
+        _sparse_set_init(__FILE__, __LINE__, (allocator), (capacity))
+
+    #define sparse_set_init_own(allocator, capacity) \
+        _sparse_set_init_own(__FILE__, __LINE__, (allocator), (capacity))
+
+    #define sparse_set_clear() \
+        _sparse_set_clear(__FILE__, __LINE__)
+
+    #define sparse_set_shutdown() \
+        _sparse_set_shutdown(__FILE__, __LINE__)
+
+    #define sparse_set_reserve(capacity) \
+        _sparse_set_reserve(__FILE__, __LINE__, (capacity))
+
+    #define sparse_set_insert(...) \
+        _sparse_set_insert(__FILE__, __LINE__, __VA_ARGS__)
+
+#else
+
+    #define sparse_set_init(allocator, capacity) \
+        _sparse_set_init((allocator), (capacity))
+
+    #define sparse_set_init_own(allocator, capacity) \
+        _sparse_set_init_own((allocator), (capacity))
+
+    #define sparse_set_clear() \
+        _sparse_set_clear()
+
+    #define sparse_set_shutdown() \
+        _sparse_set_shutdown()
+
+    #define sparse_set_reserve(capacity) \
+        _sparse_set_reserve((capacity))
+
+    #define sparse_set_insert(...) \
+        _sparse_set_insert(__VA_ARGS__)
+
+#endif
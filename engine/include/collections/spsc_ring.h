@@ -0,0 +1,118 @@
+#pragma once
+
+namespace nk::cl {
+    // Lock-free ring of variable sized blocks for one producer thread and one
+    // consumer thread, with inline storage so it never allocates. Blocks are
+    // contiguous, a block that does not fit before the end of the storage
+    // starts again from the beginning and the consumer skips the gap left
+    // behind. On an empty ring any block up to max_block_size fits.
+    template <u64 Capacity>
+        requires(std::has_single_bit(Capacity) && Capacity >= 64)
+    class spsc_ring {
+    public:
+        static constexpr u64 cache_line = 64;
+        static constexpr u64 alignment = 8;
+
+        spsc_ring()
+            : m_tail{0},
+              m_padding{0},
+              m_wrap{std::numeric_limits<u64>::max()},
+              m_head{0},
+              m_peeked{0} {}
+
+        spsc_ring(const spsc_ring&) = delete;
+        spsc_ring& operator=(const spsc_ring&) = delete;
+
+        ~spsc_ring() = default;
+
+        // Producer thread only. Room for size_bytes, aligned to 8, or nullptr
+        // when the consumer has not freed enough yet. Nothing is visible to
+        // the consumer until spsc_ring_commit.
+        u8* spsc_ring_reserve(u64 size_bytes) {
+            const u64 block = block_size(size_bytes);
+            const u64 tail = m_tail.load(std::memory_order_relaxed);
+            const u64 offset = tail & mask;
+            const u64 padding = offset + block > Capacity ? Capacity - offset : 0;
+            const u64 head = m_head.load(std::memory_order_acquire);
+
+            // With nothing left to read the gap is free, the block can take
+            // the front even if it overlaps where the tail was.
+            if (block > Capacity || (head != tail && tail + padding + block - head > Capacity))
+                return nullptr;
+
+            if (padding > 0) {
+                // Published by the release store of the tail on commit. Only
+                // one gap can be ahead of the consumer at a time.
+                m_wrap.store(tail, std::memory_order_relaxed);
+            }
+
+            m_padding = padding;
+            return m_data + ((tail + padding) & mask) + sizeof(Header);
+        }
+
+        // Publishes the last reservation, trimmed to used_bytes which can not
+        // be more than what was reserved.
+        void spsc_ring_commit(u64 used_bytes) {
+            const u64 tail = m_tail.load(std::memory_order_relaxed) + m_padding;
+            const u64 block = block_size(used_bytes);
+
+            write_header(tail & mask, block, static_cast<u32>(used_bytes));
+            m_tail.store(tail + block, std::memory_order_release);
+        }
+
+        // Consumer thread only. The oldest committed block, or nullptr.
+        const u8* spsc_ring_peek(u64& out_size_bytes) {
+            u64 head = m_head.load(std::memory_order_relaxed);
+            const u64 tail = m_tail.load(std::memory_order_acquire);
+
+            if (head == tail)
+                return nullptr;
+
+            if (head == m_wrap.load(std::memory_order_relaxed)) {
+                head += Capacity - (head & mask);
+                m_head.store(head, std::memory_order_release);
+            }
+
+            const Header& header = *reinterpret_cast<const Header*>(m_data + (head & mask));
+            m_peeked = header.size;
+            out_size_bytes = header.used;
+            return m_data + (head & mask) + sizeof(Header);
+        }
+
+        // Frees the block returned by the last spsc_ring_peek.
+        void spsc_ring_release() {
+            m_head.store(m_head.load(std::memory_order_relaxed) + m_peeked, std::memory_order_release);
+            m_peeked = 0;
+        }
+
+        bool empty() const { return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire); }
+
+        static constexpr u64 capacity() { return Capacity; }
+        // Largest block that can ever be reserved.
+        static constexpr u64 max_block_size() { return Capacity - sizeof(Header); }
+
+    private:
+        static constexpr u64 mask = Capacity - 1;
+
+        struct Header {
+            u32 size;
+            u32 used;
+        };
+
+        static constexpr u64 block_size(u64 size_bytes) {
+            return (sizeof(Header) + size_bytes + alignment - 1) & ~(alignment - 1);
+        }
+
+        void write_header(u64 offset, u64 size, u32 used) {
+            *reinterpret_cast<Header*>(m_data + offset) = {.size = static_cast<u32>(size), .used = used};
+        }
+
+        alignas(cache_line) std::atomic<u64> m_tail;
+        u64 m_padding;
+        // Position the producer last wrapped at, read by the consumer.
+        std::atomic<u64> m_wrap;
+        alignas(cache_line) std::atomic<u64> m_head;
+        u64 m_peeked;
+        alignas(cache_line) u8 m_data[Capacity];
+    };
+}
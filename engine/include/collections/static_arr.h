@@ -0,0 +1,149 @@
+#pragma once
+
+#include "collections/arr_type.h"
+
+namespace nk::cl {
+    // Array with a compile time maximum length whose elements live inline, it
+    // never touches an allocator. The storage holds N default constructed
+    // elements, slots past length() are reset to T{} when elements leave.
+    // Exposes max_length() instead of capacity() so it satisfies IArr.
+    template <IArrT T, u64 N>
+        requires(N > 0)
+    class static_arr {
+    public:
+        constexpr static_arr()
+            : m_data{},
+              m_length{0} {}
+
+        constexpr static_arr(std::initializer_list<T> list)
+            : m_data{},
+              m_length{0} {
+            Assert(list.size() <= N);
+            for (const T& value : list) {
+                m_data[m_length++] = value;
+            }
+        }
+
+        constexpr T& operator[](const u64 index) {
+            Assert(index < m_length);
+            return m_data[index];
+        }
+
+        constexpr const T& operator[](const u64 index) const {
+            Assert(index < m_length);
+            return m_data[index];
+        }
+
+        constexpr T& at(const u64 index) { return (*this)[index]; }
+        constexpr const T& at(const u64 index) const { return (*this)[index]; }
+
+        constexpr T& first() {
+            Assert(m_length > 0, "nk::cl::static_arr::first Array is empty!");
+            return m_data[0];
+        }
+
+        constexpr const T& first() const {
+            Assert(m_length > 0, "nk::cl::static_arr::first Array is empty!");
+            return m_data[0];
+        }
+
+        constexpr T& last() {
+            Assert(m_length > 0, "nk::cl::static_arr::last Array is empty!");
+            return m_data[m_length - 1];
+        }
+
+        constexpr const T& last() const {
+            Assert(m_length > 0, "nk::cl::static_arr::last Array is empty!");
+            return m_data[m_length - 1];
+        }
+
+        constexpr T& static_arr_push(T& value) {
+            Assert(m_length < N, "nk::cl::static_arr::static_arr_push Array is full!");
+            m_data[m_length] = std::move(value);
+            return m_data[m_length++];
+        }
+
+        constexpr T& static_arr_push_copy(const T& value) {
+            Assert(m_length < N, "nk::cl::static_arr::static_arr_push_copy Array is full!");
+            m_data[m_length] = value;
+            return m_data[m_length++];
+        }
+
+        constexpr void static_arr_push_range(const T* values, const u64 count) {
+            Assert(m_length + count <= N, "nk::cl::static_arr::static_arr_push_range Array is full!");
+            for (u64 i = 0; i < count; i++) {
+                m_data[m_length++] = values[i];
+            }
+        }
+
+        constexpr std::optional<T> static_arr_pop() {
+            if (m_length == 0)
+                return std::nullopt;
+
+            m_length--;
+            std::optional<T> value = std::move(m_data[m_length]);
+            m_data[m_length] = T{};
+            return value;
+        }
+
+        constexpr std::optional<T> static_arr_remove(const u64 index) {
+            if (index >= m_length)
+                return std::nullopt;
+
+            std::optional<T> value = std::move(m_data[index]);
+            for (u64 i = index + 1; i < m_length; i++) {
+                m_data[i - 1] = std::move(m_data[i]);
+            }
+            m_length--;
+            m_data[m_length] = T{};
+            return value;
+        }
+
+        constexpr std::optional<T> static_arr_swap_remove(const u64 index) {
+            if (index >= m_length)
+                return std::nullopt;
+
+            std::optional<T> value = std::move(m_data[index]);
+            m_length--;
+            if (index != m_length)
+                m_data[index] = std::move(m_data[m_length]);
+            m_data[m_length] = T{};
+            return value;
+        }
+
+        // New elements are default constructed.
+        constexpr void static_arr_resize(const u64 length) {
+            Assert(length <= N, "nk::cl::static_arr::static_arr_resize Length exceeds {}!", N);
+            for (u64 i = length; i < m_length; i++) {
+                m_data[i] = T{};
+            }
+            m_length = length;
+        }
+
+        constexpr void static_arr_reset() { static_arr_resize(0); }
+
+        constexpr T* begin() { return m_data; }
+        constexpr T* end() { return m_data + m_length; }
+        constexpr const T* begin() const { return m_data; }
+        constexpr const T* end() const { return m_data + m_length; }
+
+        constexpr std::span<T> span() { return std::span<T>(m_data, m_length); }
+        constexpr std::span<const T> span() const { return std::span<const T>(m_data, m_length); }
+        constexpr operator std::span<T>() { return span(); }
+        constexpr operator std::span<const T>() const { return span(); }
+
+        constexpr T* data() { return m_data; }
+        constexpr const T* data() const { return m_data; }
+        constexpr u64 length() const { return m_length; }
+        constexpr bool empty() const { return m_length == 0; }
+        constexpr bool full() const { return m_length == N; }
+        static constexpr u64 max_length() { return N; }
+
+    private:
+        T m_data[N];
+        u64 m_length;
+    };
+
+    template <IArrT T, u64 N>
+    using inplace_vector = static_arr<T, N>;
+}
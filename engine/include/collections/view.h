@@ -0,0 +1,69 @@
+#pragma once
+
+#include "collections/arr_type.h"
+
+namespace nk::cl {
+    // Non-owning slice over contiguous elements. Never allocates or frees,
+    // the viewed storage must outlive the view.
+    template <typename T>
+    class view {
+    public:
+        using value_type = std::remove_cv_t<T>;
+        using iterator = T*;
+
+        constexpr view()
+            : m_data{nullptr},
+              m_length{0} {}
+
+        constexpr view(T* data, u64 length)
+            : m_data{data},
+              m_length{length} {}
+
+        template <u64 N>
+        constexpr view(T (&data)[N])
+            : m_data{data},
+              m_length{N} {}
+
+        template <typename A>
+            requires HasDataLength<A, T> || HasDataLength<A, std::remove_const_t<T>>
+        constexpr view(A& other)
+            : m_data{other.data()},
+              m_length{other.length()} {}
+
+        constexpr view(std::span<T> span)
+            : m_data{span.data()},
+              m_length{span.size()} {}
+
+        constexpr operator view<const T>() const { return view<const T>(m_data, m_length); }
+        constexpr operator std::span<T>() const { return std::span<T>(m_data, m_length); }
+
+        constexpr T& operator[](const u64 index) const {
+            Assert(index < m_length);
+            return m_data[index];
+        }
+
+        constexpr view subview(const u64 offset, const u64 count) const {
+            Assert(offset + count <= m_length);
+            return view(m_data + offset, count);
+        }
+
+        constexpr view first(const u64 count) const { return subview(0, count); }
+        constexpr view last(const u64 count) const { return subview(m_length - count, count); }
+
+        constexpr iterator begin() const { return m_data; }
+        constexpr iterator end() const { return m_data + m_length; }
+
+        constexpr std::span<T> span() const { return std::span<T>(m_data, m_length); }
+
+        constexpr T* data() const { return m_data; }
+        constexpr u64 length() const { return m_length; }
+        constexpr bool empty() const { return m_length == 0; }
+
+    private:
+        T* m_data;
+        u64 m_length;
+    };
+
+    template <typename A>
+    view(A&) -> view<std::remove_pointer_t<decltype(std::declval<A&>().data())>>;
+}
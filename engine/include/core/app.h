@@ -13,6 +13,8 @@ namespace nk {
         i16 start_pos_y;
         u32 start_width;
         u32 start_height;
+        // Above zero starts the input sampling thread at that rate.
+        u32 input_sample_hz;
     };
 
     class App {
@@ -38,6 +38,7 @@ namespace nk {
     #define NK_ASSERT_3(expression, fmt, ...)                                                 \
         do {                                                                                  \
             if (!(expression)) {                                                              \
+                nk::LoggingSystem::flush();                                                   \
                 nk::report_assert_failure(#expression, __FILE__, __LINE__, fmt, __VA_ARGS__); \
                 nk::os::debug_break();                                                        \
             }                                                                                 \
@@ -46,6 +47,7 @@ namespace nk {
     #define NK_ASSERT_2(expression, msg)                                         \
         do {                                                                     \
             if (!(expression)) {                                                 \
+                nk::LoggingSystem::flush();                                      \
                 nk::report_assert_failure(#expression, __FILE__, __LINE__, msg); \
                 nk::os::debug_break();                                           \
             }                                                                    \
@@ -54,6 +56,7 @@ namespace nk {
     #define NK_ASSERT_1(expression)                                         \
         do {                                                                \
             if (!(expression)) {                                            \
+                nk::LoggingSystem::flush();                                 \
                 nk::report_assert_failure(#expression, __FILE__, __LINE__); \
                 nk::os::debug_break();                                      \
             }                                                               \
@@ -0,0 +1,302 @@
+#pragma once
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+namespace nk::hash {
+    // Fast non-cryptographic hashing based on wyhash (final version 4). Inputs
+    // longer than 48 bytes are consumed in 48 byte stripes by three independent
+    // multiply chains so the multiplier pipelines stay busy. There is no SIMD
+    // path on purpose, the result has to be the same on every build since it
+    // ends up in on-disk caches.
+    //
+    // Reads assume a little endian target, which every supported platform is.
+    static_assert(std::endian::native == std::endian::little);
+
+    struct Hash128 {
+        u64 low;
+        u64 high;
+
+        constexpr bool operator==(const Hash128&) const = default;
+    };
+
+    namespace detail {
+        static constexpr u64 secret[4] = {
+            0x2d358dccaa6c78a5ull,
+            0x8bb84b93962eacc9ull,
+            0x4b33a62ed433d4a3ull,
+            0x4d5a2da51de1aa47ull,
+        };
+
+        // Secret of the previous wyhash release, used for the high half of hash128.
+        static constexpr u64 secret_high[4] = {
+            0xa0761d6478bd642full,
+            0xe7037ed1a0b428dbull,
+            0x8ebc6af09c88c6e3ull,
+            0x589965cc75374cc3ull,
+        };
+
+        static constexpr u64 stripe_size = 48;
+
+        // 64x64 -> 128 multiply, a receives the low half and b the high half.
+        constexpr void mum(u64& a, u64& b) {
+#if defined(__SIZEOF_INT128__)
+            const __uint128_t result = static_cast<__uint128_t>(a) * b;
+            a = static_cast<u64>(result);
+            b = static_cast<u64>(result >> 64);
+#else
+    #if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+            if (!std::is_constant_evaluated()) {
+                a = _umul128(a, b, &b);
+                return;
+            }
+    #endif
+            const u64 ha = a >> 32, hb = b >> 32, la = static_cast<u32>(a), lb = static_cast<u32>(b);
+            const u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+            const u64 t = rl + (rm0 << 32);
+            u64 carry = t < rl;
+            const u64 low = t + (rm1 << 32);
+            carry += low < t;
+            a = low;
+            b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+        }
+
+        constexpr u64 mix(u64 a, u64 b) {
+            mum(a, b);
+            return a ^ b;
+        }
+
+        template <typename Byte>
+        constexpr u64 read64(const Byte* p) {
+            if (std::is_constant_evaluated()) {
+                u64 value = 0;
+                for (u64 i = 0; i < 8; i++) {
+                    value |= static_cast<u64>(static_cast<u8>(p[i])) << (8 * i);
+                }
+                return value;
+            }
+            u64 value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        template <typename Byte>
+        constexpr u64 read32(const Byte* p) {
+            if (std::is_constant_evaluated()) {
+                u64 value = 0;
+                for (u64 i = 0; i < 4; i++) {
+                    value |= static_cast<u64>(static_cast<u8>(p[i])) << (8 * i);
+                }
+                return value;
+            }
+            u32 value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        // Reads 1 to 3 bytes.
+        template <typename Byte>
+        constexpr u64 read_small(const Byte* p, const u64 length) {
+            return (static_cast<u64>(static_cast<u8>(p[0])) << 16) |
+                   (static_cast<u64>(static_cast<u8>(p[length >> 1])) << 8) |
+                   static_cast<u64>(static_cast<u8>(p[length - 1]));
+        }
+
+        constexpr u64 start(const u64 seed, const u64 (&key)[4]) {
+            return seed ^ mix(seed ^ key[0], key[1]);
+        }
+
+        template <typename Byte>
+        constexpr void stripe(const Byte* p, u64& seed, u64& see1, u64& see2, const u64 (&key)[4]) {
+            seed = mix(read64(p) ^ key[1], read64(p + 8) ^ seed);
+            see1 = mix(read64(p + 16) ^ key[2], read64(p + 24) ^ see1);
+            see2 = mix(read64(p + 32) ^ key[3], read64(p + 40) ^ see2);
+        }
+
+        constexpr u64 finish(u64 a, u64 b, const u64 seed, const u64 length, const u64 (&key)[4]) {
+            a ^= key[1];
+            b ^= seed;
+            mum(a, b);
+            return mix(a ^ key[0] ^ length, b ^ key[1]);
+        }
+
+        // Inputs of 16 bytes or less are read whole into two words.
+        template <typename Byte>
+        constexpr u64 finish_short(const Byte* p, const u64 length, const u64 seed, const u64 (&key)[4]) {
+            u64 a = 0, b = 0;
+            if (length >= 4) {
+                const u64 offset = (length >> 3) << 2;
+                a = (read32(p) << 32) | read32(p + offset);
+                b = (read32(p + length - 4) << 32) | read32(p + length - 4 - offset);
+            } else if (length > 0) {
+                a = read_small(p, length);
+            }
+            return finish(a, b, seed, length, key);
+        }
+
+        // Consumes the last 1 to 48 bytes of an input longer than 16 bytes. The
+        // final read goes back over already consumed bytes, so the 16 bytes
+        // before p must be readable when remaining is under 16.
+        template <typename Byte>
+        constexpr u64 finish_long(const Byte* p, u64 remaining, u64 seed, const u64 length, const u64 (&key)[4]) {
+            while (remaining > 16) {
+                seed = mix(read64(p) ^ key[1], read64(p + 8) ^ seed);
+                p += 16;
+                remaining -= 16;
+            }
+            return finish(read64(p + remaining - 16), read64(p + remaining - 8), seed, length, key);
+        }
+
+        template <typename Byte>
+        constexpr u64 hash(const Byte* p, const u64 length, u64 seed, const u64 (&key)[4]) {
+            seed = start(seed, key);
+            if (length <= 16)
+                return finish_short(p, length, seed, key);
+
+            u64 remaining = length;
+            if (remaining > stripe_size) {
+                u64 see1 = seed, see2 = seed;
+                do {
+                    stripe(p, seed, see1, see2, key);
+                    p += stripe_size;
+                    remaining -= stripe_size;
+                } while (remaining > stripe_size);
+                seed ^= see1 ^ see2;
+            }
+            return finish_long(p, remaining, seed, length, key);
+        }
+    }
+
+    inline u64 hash64(const void* data, const u64 length, const u64 seed = 0) {
+        return detail::hash(static_cast<const u8*>(data), length, seed, detail::secret);
+    }
+
+    // Usable in constant expressions, string("name") matches hash64 over the
+    // same bytes at runtime. Named apart from hash64 so string literals never
+    // silently take the (data, length) overload.
+    constexpr u64 string(const std::string_view text, const u64 seed = 0) {
+        return detail::hash(text.data(), text.length(), seed, detail::secret);
+    }
+
+    // Two passes with independent secrets, meant for content addressed caches
+    // where 64 bits are not enough to rule out collisions.
+    inline Hash128 hash128(const void* data, const u64 length, const u64 seed = 0) {
+        const u8* bytes = static_cast<const u8*>(data);
+        return Hash128{
+            .low = detail::hash(bytes, length, seed, detail::secret),
+            .high = detail::hash(bytes, length, seed, detail::secret_high),
+        };
+    }
+
+    constexpr Hash128 string128(const std::string_view text, const u64 seed = 0) {
+        return Hash128{
+            .low = detail::hash(text.data(), text.length(), seed, detail::secret),
+            .high = detail::hash(text.data(), text.length(), seed, detail::secret_high),
+        };
+    }
+
+    // Only types whose bytes fully define their value, floats and padded
+    // structs hash differently for equal values.
+    template <typename T>
+        requires std::has_unique_object_representations_v<T>
+    u64 hash_value(const T& value, const u64 seed = 0) {
+        return hash64(&value, sizeof(T), seed);
+    }
+
+    // Mixes a value into a running hash, the order of the calls matters.
+    constexpr u64 combine(const u64 seed, const u64 value) {
+        u64 a = seed ^ detail::secret[0];
+        u64 b = value ^ detail::secret[1];
+        detail::mum(a, b);
+        return detail::mix(a ^ detail::secret[0], b ^ detail::secret[1]);
+    }
+
+    // Incremental version of hash64, feeding the same bytes in any number of
+    // pieces gives the same result as hashing them at once.
+    class Hasher {
+    public:
+        explicit Hasher(const u64 seed = 0) { reset(seed); }
+
+        void reset(const u64 seed = 0) {
+            m_seed = detail::start(seed, detail::secret);
+            m_see1 = m_seed;
+            m_see2 = m_seed;
+            m_length = 0;
+            m_buffered = 0;
+            std::memset(m_history, 0, sizeof(m_history));
+        }
+
+        void update(const void* data, u64 length) {
+            if (length == 0)
+                return;
+
+            const u8* p = static_cast<const u8*>(data);
+            m_length += length;
+
+            if (m_buffered > 0) {
+                const u64 count = MinValue(length, detail::stripe_size - m_buffered);
+                std::memcpy(m_buffer + m_buffered, p, count);
+                m_buffered += count;
+                p += count;
+                length -= count;
+                // A full stripe stays buffered until more bytes arrive, the
+                // last one is left to finish as in hash64.
+                if (length == 0)
+                    return;
+
+                consume(m_buffer);
+            }
+
+            while (length > detail::stripe_size) {
+                consume(p);
+                p += detail::stripe_size;
+                length -= detail::stripe_size;
+            }
+
+            std::memcpy(m_buffer, p, length);
+            m_buffered = length;
+        }
+
+        void update_string(const std::string_view text) { update(text.data(), text.length()); }
+
+        template <typename T>
+            requires std::has_unique_object_representations_v<T>
+        void update_value(const T& value) {
+            update(&value, sizeof(T));
+        }
+
+        u64 finish() const {
+            if (m_length <= 16)
+                return detail::finish_short(m_buffer, m_length, m_seed, detail::secret);
+
+            u64 seed = m_seed;
+            if (m_length > detail::stripe_size)
+                seed ^= m_see1 ^ m_see2;
+
+            // The tail may read back into the last consumed stripe.
+            u8 tail[16 + detail::stripe_size];
+            std::memcpy(tail, m_history, 16);
+            std::memcpy(tail + 16, m_buffer, m_buffered);
+            return detail::finish_long(tail + 16, m_buffered, seed, m_length, detail::secret);
+        }
+
+        u64 length() const { return m_length; }
+
+    private:
+        void consume(const u8* p) {
+            detail::stripe(p, m_seed, m_see1, m_see2, detail::secret);
+            std::memcpy(m_history, p + detail::stripe_size - 16, 16);
+            m_buffered = 0;
+        }
+
+        u64 m_seed;
+        u64 m_see1;
+        u64 m_see2;
+        u64 m_length;
+        u64 m_buffered;
+        u8 m_buffer[detail::stripe_size];
+        u8 m_history[16];
+    };
+}
@@ -11,6 +11,10 @@ namespace nk::Input {
 
     bool was_key_up(KeyCodeFlag keycode);
 
+    bool is_key_pressed(KeyCodeFlag keycode);
+
+    bool is_key_released(KeyCodeFlag keycode);
+
     bool is_mouse_button_down(MouseButton button);
 
     bool is_mouse_button_up(MouseButton button);
@@ -22,4 +26,14 @@ namespace nk::Input {
     void get_mouse_position(i16& out_x, i16& out_y);
 
     void get_previous_mouse_position(i16& out_x, i16& out_y);
+
+    InputAction bind_action(u64 action_id, std::initializer_list<KeyCodeFlag> chord);
+
+    InputAction find_action(u64 action_id);
+
+    bool is_action_down(InputAction action);
+
+    bool is_action_pressed(InputAction action);
+
+    bool is_action_released(InputAction action);
 }
@@ -20,6 +20,11 @@ namespace nk {
         bool pressed;
     };
 
+    // Dense index of an action bound through InputSystem::bind_action.
+    struct InputAction {
+        u16 index;
+    };
+
     namespace KeyCode {
         enum : KeyCodeFlag {
             /** @brief The backspace key. */
@@ -71,6 +71,31 @@ namespace nk::os {
 #endif
     }
 
+    // Raw timestamp counter, only meaningful as a difference between two
+    // reads on the same machine. Falls back to steady_clock nanoseconds where
+    // there is no TSC.
+    inline u64 read_cycle_counter() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+        return __rdtsc();
+#else
+        return static_cast<u64>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    // Monotonic nanoseconds at the resolution of the scheduler tick, a few
+    // milliseconds, for checks that run too often to read a precise clock.
+    inline i64 read_coarse_time_ns() {
+#if defined(NK_PLATFORM_WINDOWS)
+        return static_cast<i64>(::GetTickCount64()) * 1'000'000;
+#elif defined(NK_PLATFORM_LINUX)
+        timespec time;
+        ::clock_gettime(CLOCK_MONOTONIC_COARSE, &time);
+        return static_cast<i64>(time.tv_sec) * 1'000'000'000 + time.tv_nsec;
+#else
+    #error Not implemented!
+#endif
+    }
+
     void* _native_allocate(u64 size_bytes, u64 alignment);
 
     void _native_free(void* data, u64 size_bytes);
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <climits>
 #include <limits>
+#include <bit>
 
 // Memory
 #include <cstring>
@@ -17,6 +18,8 @@
 #include <filesystem>
 #include <tuple>
 #include <initializer_list>
+#include <span>
+#include <iterator>
 
 // Functions
 #include <functional>
@@ -27,7 +30,9 @@
 
 // Sync
 #include <mutex>
+#include <atomic>
 #include <thread>
+#include <barrier>
 #include <chrono>
 #include <ctime>
 
@@ -35,10 +40,14 @@
 #if defined(NK_PLATFORM_WINDOWS)
     #include <windows.h>
     #include <windowsx.h>
+    #include <intrin.h>
 #elif defined(NK_PLATFORM_LINUX)
     #include <stdlib.h>
     #include <sys/stat.h>
     #include <unistd.h>
+    #if defined(__x86_64__) || defined(__i386__)
+        #include <x86intrin.h>
+    #endif
 #endif
 
 // Engine
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "vendor/glm/color.h"
+#include "collections/spsc_ring.h"
 
 namespace nk {
+    class File;
+    class FlightRecorder;
+
     enum class LoggingLevel : u8 {
         Trace,
         Debug,
@@ -19,12 +23,140 @@ namespace nk {
         std::optional<glm::color> bg = std::nullopt;
     };
 
+    // Everything a Trace, Debug or Info call site knows at compile time. In
+    // binary mode the line only stores a pointer to it and the raw bytes of
+    // its arguments, the format runs later on the writer thread or offline.
+    struct LogSite {
+        LoggingLevel level;
+        std::string_view format;
+        std::string_view file;
+        u32 line;
+        // Dynamic width or precision, "{:>{}}", needs the other arguments
+        // while formatting one and only works on the text path.
+        bool text_only;
+        // Owned by the writer thread, the id of the site in the binary output
+        // and in the flight recorder.
+        u32 binary_id;
+        u32 binary_generation;
+        u32 recorder_id;
+        u32 recorder_generation;
+    };
+
+    // Each argument of a binary line is its tag and 8 bytes, strings are
+    // their tag, a u32 size and their bytes. Floats keep their own width so
+    // they print the same as on the text path.
+    enum class LogArgument : u8 {
+        I64,
+        U64,
+        F64,
+        Bool,
+        Char,
+        String,
+        Pointer,
+        F32,
+    };
+
+    template <typename T>
+    concept ILogString = std::same_as<T, std::string> || std::same_as<T, std::string_view> ||
+                         std::same_as<T, char*> || std::same_as<T, const char*>;
+
+    template <typename T>
+    concept ILogArgument = std::integral<T> || std::same_as<T, f32> || std::same_as<T, f64> ||
+                           std::is_pointer_v<T> || ILogString<T>;
+
+    // Path of a source file relative to the project, resolved at compile
+    // time so lines do not search for it.
+    consteval std::string_view log_file(std::string_view file) {
+#ifdef NK_PROJECT_PATH
+        constexpr std::string_view project_path = NK_PROJECT_PATH;
+        const std::size_t position = file.find(project_path);
+        if (position != std::string_view::npos && file.size() > position + project_path.size()) {
+            return file.substr(position + project_path.size() + 1);
+        }
+#endif
+        return file;
+    }
+
+    // True when a replacement field of format nests another one, as a
+    // dynamic width or precision does.
+    consteval bool log_format_nested(std::string_view format) {
+        bool in_field = false;
+        for (std::size_t i = 0; i < format.size(); i++) {
+            if (format[i] == '{') {
+                if (in_field)
+                    return true;
+                if (i + 1 < format.size() && format[i + 1] == '{') {
+                    i++;
+                    continue;
+                }
+                in_field = true;
+            } else if (format[i] == '}') {
+                if (!in_field && i + 1 < format.size() && format[i + 1] == '}') {
+                    i++;
+                    continue;
+                }
+                in_field = false;
+            }
+        }
+        return false;
+    }
+
+    // Where formatted lines go. The console and the file output are sinks,
+    // more can be added with LoggingSystem::add_sink. Calls come from the
+    // writer thread, or the logging thread when not async, one at a time.
+    class LogSink {
+    public:
+        virtual ~LogSink() = default;
+
+        // Whole lines, with the console colors when colored returns true.
+        virtual void write(std::string_view lines) = 0;
+        // After every batch, a sink with its own buffer writes it when due.
+        virtual void idle() {}
+        // After Error and Fatal lines, LoggingSystem::flush and shutdown.
+        virtual void flush() = 0;
+        virtual bool colored() const { return false; }
+    };
+
     struct LoggingSystemConfig {
         LoggingColor style[static_cast<u8>(LoggingLevel::Off)];
         LoggingLevel priority;
         bool show_file;
         bool show_time;
+        // Plain text lines to file_path through a large buffer. The file is
+        // renamed to file_path with the time before its extension once it
+        // is over file_max_size or older than file_max_age_seconds, 0 turns
+        // either off. A log left by a previous run is rotated on init.
         bool file_output;
+        cstr file_path;
+        u64 file_max_size;
+        u64 file_max_age_seconds;
+        // Rotated files kept, the oldest are removed.
+        u32 file_max_backups;
+        // Rotated files are compressed on a background thread, log_decoder
+        // turns them back into text.
+        bool file_compress;
+        // The buffer is written at least this often and after Error lines.
+        u32 file_flush_interval_ms;
+        // Callers only copy their line into a ring of their thread, a writer
+        // thread formats and writes the lines in batches.
+        bool async;
+        // Binary lines go to this file as they are, log_decoder turns it into
+        // text. Only Error and Fatal still reach the sinks. Null formats
+        // them on the writer thread.
+        cstr binary_output;
+        // The last flight_recorder_size bytes of lines from
+        // flight_recorder_priority up, below the priority of the other
+        // outputs too, kept in a mapped file that survives a crash.
+        // log_decoder reads it. Null turns it off, it needs async.
+        cstr flight_recorder;
+        u64 flight_recorder_size;
+        LoggingLevel flight_recorder_priority;
+        // Every WarnLogLimited and ErrorLogLimited call site logs up to
+        // rate_limit_burst lines at once, then rate_limit_per_second. The
+        // lines past that are dropped and the next line it logs says how
+        // many. 0 per second turns it off.
+        u32 rate_limit_per_second;
+        u32 rate_limit_burst;
     };
 
     class LoggingSystem {
@@ -46,21 +178,215 @@ namespace nk {
             config.show_file = true;
             config.show_time = true;
             config.file_output = true;
+            config.file_path = "nk.log";
+            config.file_max_size = MiB(16);
+            config.file_max_age_seconds = 24 * 60 * 60;
+            config.file_max_backups = 8;
+            config.file_compress = true;
+            config.file_flush_interval_ms = 1000;
+            config.async = true;
+            config.binary_output = nullptr;
+            config.flight_recorder = nullptr;
+            config.flight_recorder_size = MiB(8);
+            config.flight_recorder_priority = LoggingLevel::Trace;
+            config.rate_limit_per_second = 10;
+            config.rate_limit_burst = 20;
             return config;
         }
 
+        static constexpr u64 ring_capacity = KiB(64);
+        static constexpr u64 max_threads = 64;
+        // Messages up to this size are formatted straight into the ring.
+        static constexpr u64 inline_message_size = 256;
+        // Larger lines take the synchronous path so they never hold most of a
+        // ring and starve the other lines of the thread.
+        static constexpr u64 max_ring_message_size = ring_capacity / 2;
+        static constexpr u64 batch_size = KiB(64);
+        static constexpr u64 max_binary_arguments = 16;
+        static constexpr u64 max_sinks = 8;
+
+        // Header of every line in a thread ring, the message fills the rest
+        // of the block. file has to outlive the line, __FILE__ does.
+        struct LogRecord {
+            i64 timestamp_ns;
+            // Set for binary lines, the block holds the encoded arguments.
+            LogSite* site;
+            cstr file;
+            u32 file_size;
+            u32 line;
+            LoggingLevel level;
+        };
+
+        using LogRing = cl::spsc_ring<ring_capacity>;
+
+        // The format is checked and parsed at compile time. Without
+        // arguments the message overload below takes the call and prints
+        // the text as is.
         template <typename... Args>
-        static void log(LoggingLevel level, std::string_view file, u32 line, std::string_view fmt, Args&&... args) {
+        static void log(LoggingLevel level, std::string_view file, u32 line, std::format_string<Args...> fmt, Args&&... args) {
+            if (LogRing* ring = get().m_async ? thread_ring() : nullptr) {
+                char* message = begin_record(ring, level, file, line, inline_message_size);
+                if (message == nullptr)
+                    return;
+
+                const auto result = std::format_to_n(message, inline_message_size, fmt, std::forward<Args>(args)...);
+                if (static_cast<u64>(result.size) <= inline_message_size) {
+                    end_record(ring, level, result.size);
+                    return;
+                }
+                // Too long for the inline space, the reservation is dropped.
+            }
+
             std::string buffer;
-            std::vformat_to(std::back_inserter(buffer), fmt, std::make_format_args(args...));
+            std::format_to(std::back_inserter(buffer), fmt, std::forward<Args>(args)...);
             log(level, file, line, buffer);
         }
 
         static void log(LoggingLevel level, std::string_view file, u32 line, std::string_view message);
 
+        // Binary path of the Trace, Debug and Info macros. Arguments that are
+        // not numbers, pointers or strings make the line a text one, so do
+        // long doubles which do not fit in the 8 bytes of an argument.
+        // fmt is the format of the site again, so the compiler checks it.
+        template <typename... Args>
+        static void log_site(LogSite& site, std::format_string<Args...> fmt, Args&&... args) {
+            if constexpr (sizeof...(Args) > max_binary_arguments || !(ILogArgument<std::decay_t<Args>> && ...)) {
+                log(site.level, site.file, site.line, fmt, std::forward<Args>(args)...);
+            } else {
+                const u64 size = (argument_size(args) + ... + 0);
+                LogRing* ring = get().m_async && !site.text_only ? thread_ring() : nullptr;
+                if (ring == nullptr || size > max_ring_message_size) {
+                    log(site.level, site.file, site.line, fmt, std::forward<Args>(args)...);
+                    return;
+                }
+
+                char* data = begin_record(ring, site.level, site.file, site.line, size, &site);
+                if (data == nullptr)
+                    return;
+
+                u8* out = reinterpret_cast<u8*>(data);
+                (encode_argument(out, args), ...);
+                end_record(ring, site.level, size);
+            }
+        }
+
+        static void log_site(LogSite& site, std::string_view message);
+
+        // Checked by the macros before the arguments are evaluated, true for
+        // lines of the flight recorder too.
+        static bool enabled(LoggingLevel level) { return level >= get().m_capture_priority.load(std::memory_order_relaxed); }
+        // Of every output but the flight recorder.
+        static void set_priority(LoggingLevel priority);
+
+        // Token bucket of the rate limited macros, 0 when they are off.
+        static i64 rate_interval_ns() { return get().m_rate_interval_ns; }
+        // How far ahead of now a site may empty its bucket, the burst.
+        static i64 rate_burst_ns() { return get().m_rate_burst_ns; }
+
+        // " [Level]: " as printed before the message.
+        static std::string_view level_prefix(LoggingLevel level) {
+            if (level >= LoggingLevel::None)
+                return " ";
+            return {logging_level[static_cast<u8>(level)].value, logging_level[static_cast<u8>(level)].size};
+        }
+
+        // Writes every line logged so far before returning, from any thread.
+        // Fatal lines flush on their own, so does shutdown.
+        static void flush();
+
+        // Lines lost to a full ring, Warning and below never wait for room.
+        static u64 dropped_count() { return get().m_dropped.load(std::memory_order_relaxed); }
+
+        // The sink gets every line from now on, until it is removed or the
+        // system shuts down. It stays owned by the caller.
+        static bool add_sink(LogSink* sink);
+        static void remove_sink(LogSink* sink);
+
     private:
         LoggingSystem() = default;
 
+        // The ring of the calling thread, created on its first line. Null
+        // once max_threads rings exist, those threads write synchronously.
+        static LogRing* thread_ring();
+        // Reserves the record and returns where message_size bytes of the
+        // message go, null when the line is dropped.
+        static char* begin_record(LogRing* ring, LoggingLevel level, std::string_view file, u32 line, u64 message_size, LogSite* site = nullptr);
+        static void end_record(LogRing* ring, LoggingLevel level, u64 message_size);
+
+        template <typename T>
+        static constexpr u64 argument_size(const T& value) {
+            using Type = std::decay_t<T>;
+            if constexpr (std::same_as<Type, char*> || std::same_as<Type, const char*>) {
+                return 1 + sizeof(u32) + (value ? std::strlen(value) : 0);
+            } else if constexpr (ILogString<Type>) {
+                return 1 + sizeof(u32) + value.size();
+            } else {
+                return 1 + sizeof(u64);
+            }
+        }
+
+        template <typename T>
+        static void encode_argument(u8*& out, const T& value) {
+            using Type = std::decay_t<T>;
+            if constexpr (ILogString<Type>) {
+                std::string_view string;
+                if constexpr (std::is_pointer_v<Type>) {
+                    string = value ? std::string_view(value) : std::string_view();
+                } else {
+                    string = value;
+                }
+
+                const u32 size = static_cast<u32>(string.size());
+                *out++ = static_cast<u8>(LogArgument::String);
+                std::memcpy(out, &size, sizeof(size));
+                std::memcpy(out + sizeof(size), string.data(), size);
+                out += sizeof(size) + size;
+                return;
+            } else {
+                LogArgument type;
+                u64 bits = 0;
+                if constexpr (std::same_as<Type, bool>) {
+                    type = LogArgument::Bool;
+                    bits = value;
+                } else if constexpr (std::same_as<Type, char>) {
+                    type = LogArgument::Char;
+                    bits = static_cast<u8>(value);
+                } else if constexpr (std::same_as<Type, f32>) {
+                    type = LogArgument::F32;
+                    std::memcpy(&bits, &value, sizeof(value));
+                } else if constexpr (std::same_as<Type, f64>) {
+                    type = LogArgument::F64;
+                    std::memcpy(&bits, &value, sizeof(value));
+                } else if constexpr (std::is_pointer_v<Type>) {
+                    type = LogArgument::Pointer;
+                    bits = reinterpret_cast<std::uintptr_t>(value);
+                } else if constexpr (std::is_signed_v<Type>) {
+                    type = LogArgument::I64;
+                    bits = static_cast<u64>(static_cast<i64>(value));
+                } else {
+                    type = LogArgument::U64;
+                    bits = value;
+                }
+
+                *out++ = static_cast<u8>(type);
+                std::memcpy(out, &bits, sizeof(bits));
+                out += sizeof(bits);
+            }
+        }
+
+        // The full line, time, level, message and file.
+        void format_line(const LogRecord& record, std::string_view message, std::string& out, bool colored);
+        // Into the batch of every kind of sink there is.
+        void append_line(const LogRecord& record, std::string_view message);
+        // Hands the batches to the sinks, then flushes them or lets them idle.
+        void write_sinks(bool flush);
+        void writer_loop();
+        // Formats and writes what the rings hold, false when they were empty.
+        bool drain(bool flush);
+        // The record as entries of the binary output, its site first when
+        // the file has not seen it yet.
+        void append_binary(const LogRecord& record, const u8* payload, u64 size_bytes);
+
         static constexpr LoggingColor default_style[static_cast<u8>(LoggingLevel::Off)] = {
             {.fg = rgb(170, 129, 246)},                          // Trace
             {.fg = rgb(166, 226, 46)},                           // Debug
@@ -86,70 +412,224 @@ namespace nk {
         };
 
         std::string m_style[static_cast<u8>(LoggingLevel::Off)];
-        LoggingLevel m_priority;
+        // Only set when log_file could not strip the path at compile time.
+        std::string m_project_path;
+        std::atomic<LoggingLevel> m_priority;
+        // The lower of m_priority and the one of the flight recorder.
+        std::atomic<LoggingLevel> m_capture_priority;
+        LoggingLevel m_recorder_priority;
+        i64 m_rate_interval_ns;
+        i64 m_rate_burst_ns;
         bool m_show_file;
         bool m_show_time;
-        bool m_file_output;
+        bool m_async;
+
+        LogRing* m_rings[max_threads];
+        std::atomic<u32> m_ring_count;
+        // Bumped by init and shutdown so threads drop the rings they cached.
+        std::atomic<u32> m_generation;
+        std::mutex m_rings_mutex;
+
+        // Held by whoever writes to the sinks, the writer thread, a flush or
+        // a synchronous line.
+        std::mutex m_drain_mutex;
+        LogSink* m_sinks[max_sinks];
+        u32 m_sink_count;
+        u32 m_colored_sinks;
+        LogSink* m_file_sink;
+        std::string m_batch;
+        std::string m_plain_batch;
+        std::thread m_writer;
+        std::atomic<bool> m_writer_running;
+        std::atomic<u64> m_dropped;
+        u64 m_dropped_reported;
+
+        File* m_binary_file;
+        FlightRecorder* m_flight_recorder;
+        std::string m_binary_batch;
+        std::string m_message;
+        u32 m_binary_generation;
+        u32 m_next_site_id;
+    };
+
+    // State of a rate limited call site, zero in the static storage of the
+    // macro. The bucket is kept as the time it runs empty at, on the coarse
+    // clock. A suppressed line reads the clock, loads it and counts itself.
+    // An admitted line is not a single load, it takes its token with a
+    // compare-exchange loop that retries while other threads take theirs.
+    struct LogLimit {
+        std::atomic<i64> empty_at_ns;
+        std::atomic<u32> suppressed;
+
+        bool admit(LoggingLevel level, std::string_view file, u32 line) {
+            const i64 interval = LoggingSystem::rate_interval_ns();
+            if (interval == 0)
+                return true;
+
+            const i64 now = os::read_coarse_time_ns();
+            i64 empty_at = empty_at_ns.load(std::memory_order_relaxed);
+            do {
+                if (empty_at - now > LoggingSystem::rate_burst_ns()) {
+                    suppressed.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+            } while (!empty_at_ns.compare_exchange_weak(empty_at, MaxValue(empty_at, now) + interval, std::memory_order_relaxed));
+
+            if (const u32 count = suppressed.exchange(0, std::memory_order_relaxed); count > 0) {
+                LoggingSystem::log(level, file, line, "{} lines of this call site were suppressed.", count);
+            }
+            return true;
+        }
     };
 }
 
-#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO
-    #define NK_LOG_TRACE_ENABLED TRUE
-    #define NK_LOG_DEBUG_ENABLED TRUE
+// Binary lines cost little enough to build with Trace and Debug enabled
+// and NK_LOG_TRACE_ENABLED / NK_LOG_DEBUG_ENABLED defined to TRUE.
+#ifndef NK_LOG_TRACE_ENABLED
+    #if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO
+        #define NK_LOG_TRACE_ENABLED TRUE
+    #else
+        #define NK_LOG_TRACE_ENABLED FALSE
+    #endif
+#endif
+
+#ifndef NK_LOG_DEBUG_ENABLED
+    #if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO
+        #define NK_LOG_DEBUG_ENABLED TRUE
+    #else
+        #define NK_LOG_DEBUG_ENABLED FALSE
+    #endif
+#endif
+
+// Trace, Debug and Info lines store their arguments and format later.
+#ifndef NK_LOG_BINARY
+    #define NK_LOG_BINARY TRUE
+#endif
+
+// The level is checked before the arguments are evaluated, the file is made
+// relative at compile time.
+#define _NK_LOG_TEXT(log_level, ...)                                                              \
+    do {                                                                                          \
+        if (nk::LoggingSystem::enabled(log_level))                                                \
+            nk::LoggingSystem::log(log_level, nk::log_file(__FILE__), __LINE__, __VA_ARGS__);     \
+    } while (false)
+
+// Opt in per call site, for lines that can repeat every frame. Lines past
+// the token bucket of the site are dropped, not just delayed.
+#define _NK_LOG_LIMITED(log_level, ...)                                                                                 \
+    do {                                                                                                                \
+        static constinit nk::LogLimit _nk_log_limit = {};                                                               \
+        if (nk::LoggingSystem::enabled(log_level) && _nk_log_limit.admit(log_level, nk::log_file(__FILE__), __LINE__)) \
+            nk::LoggingSystem::log(log_level, nk::log_file(__FILE__), __LINE__, __VA_ARGS__);                           \
+    } while (false)
+
+// The first line of the call site, or every n-th one, through log_macro.
+// An n of 0 never logs.
+#define _NK_LOG_ONCE(log_macro, log_level, ...)                                                                        \
+    do {                                                                                                               \
+        static constinit std::atomic<bool> _nk_log_done = false;                                                       \
+        if (nk::LoggingSystem::enabled(log_level) && !_nk_log_done.load(std::memory_order_relaxed) &&                  \
+            !_nk_log_done.exchange(true, std::memory_order_relaxed))                                                   \
+            log_macro(log_level, __VA_ARGS__);                                                                         \
+    } while (false)
+
+#define _NK_LOG_EVERY(n, log_macro, log_level, ...)                                                                    \
+    do {                                                                                                               \
+        static constinit std::atomic<nk::u64> _nk_log_count = 0;                                                       \
+        if (nk::LoggingSystem::enabled(log_level)) {                                                                   \
+            const nk::u64 _nk_log_every = (n);                                                                         \
+            if (_nk_log_every != 0 && _nk_log_count.fetch_add(1, std::memory_order_relaxed) % _nk_log_every == 0)      \
+                log_macro(log_level, __VA_ARGS__);                                                                     \
+        }                                                                                                              \
+    } while (false)
+
+#if NK_LOG_BINARY
+    #define _NK_LOG_SITE(log_level, fmt, ...)                                                  \
+        do {                                                                                   \
+            static constinit nk::LogSite _nk_log_site = {                                      \
+                .level = log_level,                                                            \
+                .format = fmt,                                                                 \
+                .file = nk::log_file(__FILE__),                                                \
+                .line = __LINE__,                                                              \
+                .text_only = nk::log_format_nested(fmt),                                       \
+            };                                                                                 \
+            if (nk::LoggingSystem::enabled(log_level))                                         \
+                nk::LoggingSystem::log_site(_nk_log_site, fmt __VA_OPT__(, ) __VA_ARGS__);     \
+        } while (false)
 #else
-    #define NK_LOG_TRACE_ENABLED FALSE
-    #define NK_LOG_DEBUG_ENABLED FALSE
+    #define _NK_LOG_SITE(log_level, ...) _NK_LOG_TEXT(log_level, __VA_ARGS__)
 #endif
 
 #define NK_LOG_INFO_ENABLED TRUE
 #define NK_LOG_WARN_ENABLED TRUE
 
 #if NK_LOG_TRACE_ENABLED
-    #define TraceLog(...) nk::LoggingSystem::log(nk::LoggingLevel::Trace, __FILE__, __LINE__, __VA_ARGS__)
+    #define TraceLog(...) _NK_LOG_SITE(nk::LoggingLevel::Trace, __VA_ARGS__)
     #define TraceLogIf(condition, ...) \
         if (condition)                 \
-        nk::LoggingSystem::log(nk::LoggingLevel::Trace, __FILE__, __LINE__, __VA_ARGS__)
+        _NK_LOG_SITE(nk::LoggingLevel::Trace, __VA_ARGS__)
+    #define TraceLogOnce(...) _NK_LOG_ONCE(_NK_LOG_SITE, nk::LoggingLevel::Trace, __VA_ARGS__)
+    #define TraceLogEvery(n, ...) _NK_LOG_EVERY(n, _NK_LOG_SITE, nk::LoggingLevel::Trace, __VA_ARGS__)
 #else
     #define TraceLog(...)
     #define TraceLogIf(condition, ...)
+    #define TraceLogOnce(...)
+    #define TraceLogEvery(n, ...)
 #endif
 
 #if NK_LOG_DEBUG_ENABLED
-    #define DebugLog(...) nk::LoggingSystem::log(nk::LoggingLevel::Debug, __FILE__, __LINE__, __VA_ARGS__)
+    #define DebugLog(...) _NK_LOG_SITE(nk::LoggingLevel::Debug, __VA_ARGS__)
     #define DebugLogIf(condition, ...) \
         if (condition)                 \
-        nk::LoggingSystem::log(nk::LoggingLevel::Debug, __FILE__, __LINE__, __VA_ARGS__)
+        _NK_LOG_SITE(nk::LoggingLevel::Debug, __VA_ARGS__)
+    #define DebugLogOnce(...) _NK_LOG_ONCE(_NK_LOG_SITE, nk::LoggingLevel::Debug, __VA_ARGS__)
+    #define DebugLogEvery(n, ...) _NK_LOG_EVERY(n, _NK_LOG_SITE, nk::LoggingLevel::Debug, __VA_ARGS__)
 #else
     #define DebugLog(...)
     #define DebugLogIf(condition, ...)
+    #define DebugLogOnce(...)
+    #define DebugLogEvery(n, ...)
 #endif
 
 #if NK_LOG_INFO_ENABLED
-    #define InfoLog(...) nk::LoggingSystem::log(nk::LoggingLevel::Info, __FILE__, __LINE__, __VA_ARGS__)
+    #define InfoLog(...) _NK_LOG_SITE(nk::LoggingLevel::Info, __VA_ARGS__)
     #define InfoLogIf(condition, ...) \
         if (condition)                \
-        nk::LoggingSystem::log(nk::LoggingLevel::Info, __FILE__, __LINE__, __VA_ARGS__)
+        _NK_LOG_SITE(nk::LoggingLevel::Info, __VA_ARGS__)
+    #define InfoLogOnce(...) _NK_LOG_ONCE(_NK_LOG_SITE, nk::LoggingLevel::Info, __VA_ARGS__)
+    #define InfoLogEvery(n, ...) _NK_LOG_EVERY(n, _NK_LOG_SITE, nk::LoggingLevel::Info, __VA_ARGS__)
 #else
     #define InfoLog(...)
     #define InfoLogIf(condition, ...)
+    #define InfoLogOnce(...)
+    #define InfoLogEvery(n, ...)
 #endif
 
 #if NK_LOG_WARN_ENABLED
-    #define WarnLog(...) nk::LoggingSystem::log(nk::LoggingLevel::Warning, __FILE__, __LINE__, __VA_ARGS__)
+    #define WarnLog(...) _NK_LOG_TEXT(nk::LoggingLevel::Warning, __VA_ARGS__)
     #define WarnLogIf(condition, ...) \
         if (condition)                \
-        nk::LoggingSystem::log(nk::LoggingLevel::Warning, __FILE__, __LINE__, __VA_ARGS__)
+        _NK_LOG_TEXT(nk::LoggingLevel::Warning, __VA_ARGS__)
+    #define WarnLogLimited(...) _NK_LOG_LIMITED(nk::LoggingLevel::Warning, __VA_ARGS__)
+    #define WarnLogOnce(...) _NK_LOG_ONCE(_NK_LOG_TEXT, nk::LoggingLevel::Warning, __VA_ARGS__)
+    #define WarnLogEvery(n, ...) _NK_LOG_EVERY(n, _NK_LOG_TEXT, nk::LoggingLevel::Warning, __VA_ARGS__)
 #else
     #define WarnLog(...)
     #define WarnLogIf(condition, ...)
+    #define WarnLogLimited(...)
+    #define WarnLogOnce(...)
+    #define WarnLogEvery(n, ...)
 #endif
 
-#define ErrorLog(...) nk::LoggingSystem::log(nk::LoggingLevel::Error, __FILE__, __LINE__, __VA_ARGS__)
+#define ErrorLog(...) _NK_LOG_TEXT(nk::LoggingLevel::Error, __VA_ARGS__)
 #define ErrorLogIf(condition, ...) \
     if (condition)                 \
-    nk::LoggingSystem::log(nk::LoggingLevel::Error, __FILE__, __LINE__, __VA_ARGS__)
+    _NK_LOG_TEXT(nk::LoggingLevel::Error, __VA_ARGS__)
+#define ErrorLogLimited(...) _NK_LOG_LIMITED(nk::LoggingLevel::Error, __VA_ARGS__)
+#define ErrorLogOnce(...) _NK_LOG_ONCE(_NK_LOG_TEXT, nk::LoggingLevel::Error, __VA_ARGS__)
+#define ErrorLogEvery(n, ...) _NK_LOG_EVERY(n, _NK_LOG_TEXT, nk::LoggingLevel::Error, __VA_ARGS__)
 
-#define FatalLog(...) nk::LoggingSystem::log(nk::LoggingLevel::Fatal, __FILE__, __LINE__, __VA_ARGS__)
+#define FatalLog(...) _NK_LOG_TEXT(nk::LoggingLevel::Fatal, __VA_ARGS__)
 #define FatalLogIf(condition, ...) \
     if (condition)                 \
-    nk::LoggingSystem::log(nk::LoggingLevel::Fatal, __FILE__, __LINE__, __VA_ARGS__)
+    _NK_LOG_TEXT(nk::LoggingLevel::Fatal, __VA_ARGS__)
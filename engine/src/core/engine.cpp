@@ -7,6 +7,8 @@
 #include "platform/platform.h"
 #include "renderer/renderer.h"
 #include "systems/input_system.h"
+#include "systems/timer_system.h"
+#include "systems/event_recorder.h"
 
 // TODO: Temporal include
 #include "core/camera.h"
@@ -106,17 +108,23 @@ namespace nk {
 
         m_clock.init(m_platform);
 
-        EventSystem::register_event(SystemEventCode::ApplicationQuit, nullptr, on_event);
-        EventSystem::register_event(SystemEventCode::KeyPressed, nullptr, on_key);
-        EventSystem::register_event(SystemEventCode::KeyReleased, nullptr, on_key);
-        EventSystem::register_event(SystemEventCode::Resized, nullptr, on_resized);
+        if (m_app->initial_config.input_sample_hz > 0) {
+            InputSystem::start_sampling([](void* platform) { static_cast<Platform*>(platform)->sample_input(); },
+                                        m_platform, m_app->initial_config.input_sample_hz);
+        }
+
+        m_event_handles[0] = EventSystem::register_event(SystemEventCode::ApplicationQuit, nullptr, on_event);
+        m_event_handles[1] = EventSystem::register_event(SystemEventCode::KeyPressed, nullptr, on_key);
+        m_event_handles[2] = EventSystem::register_event(SystemEventCode::KeyReleased, nullptr, on_key);
+        m_event_handles[3] = EventSystem::register_event(SystemEventCode::Resized, nullptr, on_resized);
     }
 
     void Engine::shutdown_impl() {
-        EventSystem::unregister_event(SystemEventCode::ApplicationQuit, nullptr, on_event);
-        EventSystem::unregister_event(SystemEventCode::KeyPressed, nullptr, on_key);
-        EventSystem::unregister_event(SystemEventCode::KeyReleased, nullptr, on_key);
-        EventSystem::unregister_event(SystemEventCode::Resized, nullptr, on_resized);
+        for (EventHandle handle : m_event_handles) {
+            EventSystem::unregister_event(handle);
+        }
+
+        InputSystem::stop_sampling();
 
         Renderer::destroy(m_allocator, m_renderer);
         Platform::destroy(m_allocator, m_platform);
@@ -134,17 +142,33 @@ namespace nk {
         f64 target_frame_seconds = 1.0f / 60;
 
         while (m_platform->running()) {
+            // Everything posted while pumping and applying the sampled input
+            // is outside input, the recorder saves it or swaps it for the
+            // recorded frame.
+            EventRecorder::begin_capture();
             if (!m_platform->pump_messages()) {
                 m_platform->close();
             }
+            InputSystem::consume_samples();
+            EventRecorder::end_capture();
+
+            // Deliver everything queued while pumping messages. It runs even
+            // while suspended, the resize that resumes the app comes through here.
+            EventSystem::dispatch();
+            InputSystem::evaluate_actions();
 
             if (!m_platform->suspended()) {
                 // Update clock and get delta time
                 m_clock.update();
                 f64 current_time = m_clock.elapsed();
                 f64 delta = current_time - m_last_time;
+                if (EventRecorder::replaying())
+                    delta = EventRecorder::fixed_delta();
                 f64 frame_start_time = m_platform->get_absolute_time();
 
+                TimerSystem::update(delta);
+                NK_EVENT_STATS_UPDATE(delta);
+
                 if (!update(delta)) {
                     FatalLog("nk::App::run update failed. shutting douwn.");
                     m_platform->close();
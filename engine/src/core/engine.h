@@ -46,6 +46,8 @@ namespace nk {
         Clock m_clock;
         f64 m_last_time;
 
+        EventHandle m_event_handles[4];
+
         friend bool on_resized(SystemEventCode, void*, void*, EventContext);
     };
 }
@@ -5,6 +5,8 @@
 #include "systems/memory_system.h"
 #include "systems/event_system.h"
 #include "systems/input_system.h"
+#include "systems/timer_system.h"
+#include "systems/event_recorder.h"
 #include "core/engine.h"
 
 namespace nk {
@@ -16,6 +18,18 @@ namespace nk {
             LoggingSystem::init();
             EventSystem::init();
             InputSystem::init();
+            TimerSystem::init();
+            EventRecorder::init();
+
+            // --record <file> saves the input of the run, --replay <file>
+            // plays it back with a fixed delta time and quits at its end.
+            for (int i = 1; i + 1 < argc; i++) {
+                if (std::strcmp(argv[i], "--record") == 0) {
+                    EventRecorder::start_recording(argv[++i]);
+                } else if (std::strcmp(argv[i], "--replay") == 0) {
+                    EventRecorder::start_replay(argv[++i]);
+                }
+            }
 
             Engine::init();
             NK_MEMORY_SYSTEM_INTERMEDIATE_LOG_REPORT();
@@ -23,6 +37,8 @@ namespace nk {
             Engine::shutdown();
             NK_MEMORY_SYSTEM_INTERMEDIATE_LOG_REPORT();
 
+            EventRecorder::shutdown();
+            TimerSystem::shutdown();
             InputSystem::shutdown();
             EventSystem::shutdown();
             LoggingSystem::shutdown();
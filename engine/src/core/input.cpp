@@ -21,6 +21,14 @@ namespace nk::Input {
         return InputSystem::get().was_key_up(keycode);
     }
 
+    bool is_key_pressed(KeyCodeFlag keycode) {
+        return InputSystem::get().is_key_pressed(keycode);
+    }
+
+    bool is_key_released(KeyCodeFlag keycode) {
+        return InputSystem::get().is_key_released(keycode);
+    }
+
     bool is_mouse_button_down(MouseButton button) {
         return InputSystem::get().is_mouse_button_down(button);
     }
@@ -44,4 +52,24 @@ namespace nk::Input {
     void get_previous_mouse_position(i16& out_x, i16& out_y) {
         InputSystem::get().get_previous_mouse_position(out_x, out_y);
     }
+
+    InputAction bind_action(u64 action_id, std::initializer_list<KeyCodeFlag> chord) {
+        return InputSystem::bind_action(action_id, chord);
+    }
+
+    InputAction find_action(u64 action_id) {
+        return InputSystem::find_action(action_id);
+    }
+
+    bool is_action_down(InputAction action) {
+        return InputSystem::get().is_action_down(action);
+    }
+
+    bool is_action_pressed(InputAction action) {
+        return InputSystem::get().is_action_pressed(action);
+    }
+
+    bool is_action_released(InputAction action) {
+        return InputSystem::get().is_action_released(action);
+    }
 }
@@ -0,0 +1,86 @@
+#include "nkpch.h"
+
+#include "platform/mapped_file.h"
+
+#if !defined(NK_PLATFORM_WINDOWS)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+#endif
+
+namespace nk {
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    bool MappedFile::open(cstr path, u64 size_bytes) {
+        close();
+
+#if defined(NK_PLATFORM_WINDOWS)
+        m_file = ::CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (m_file == INVALID_HANDLE_VALUE) {
+            ErrorLog("Failed to create mapped file: {}", path);
+            return false;
+        }
+
+        m_mapping = ::CreateFileMappingA(m_file, NULL, PAGE_READWRITE, static_cast<DWORD>(size_bytes >> 32), static_cast<DWORD>(size_bytes), NULL);
+        if (m_mapping == nullptr) {
+            ErrorLog("Failed to map file: {}", path);
+            close();
+            return false;
+        }
+
+        m_data = static_cast<u8*>(::MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size_bytes));
+#else
+        m_file = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (m_file < 0) {
+            ErrorLog("Failed to create mapped file: {}", path);
+            return false;
+        }
+
+        if (::ftruncate(m_file, static_cast<off_t>(size_bytes)) != 0) {
+            ErrorLog("Failed to resize mapped file: {}", path);
+            close();
+            return false;
+        }
+
+        void* data = ::mmap(nullptr, size_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_file, 0);
+        m_data = data == MAP_FAILED ? nullptr : static_cast<u8*>(data);
+#endif
+
+        if (m_data == nullptr) {
+            ErrorLog("Failed to map file: {}", path);
+            close();
+            return false;
+        }
+
+        m_size = size_bytes;
+        return true;
+    }
+
+    void MappedFile::close() {
+#if defined(NK_PLATFORM_WINDOWS)
+        if (m_data != nullptr) {
+            ::UnmapViewOfFile(m_data);
+        }
+        if (m_mapping != nullptr) {
+            ::CloseHandle(m_mapping);
+            m_mapping = nullptr;
+        }
+        if (m_file != INVALID_HANDLE_VALUE) {
+            ::CloseHandle(m_file);
+            m_file = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (m_data != nullptr) {
+            ::munmap(m_data, m_size);
+        }
+        if (m_file >= 0) {
+            ::close(m_file);
+            m_file = -1;
+        }
+#endif
+
+        m_data = nullptr;
+        m_size = 0;
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+namespace nk {
+    // A file mapped read-write into memory. Stores go to the page cache of
+    // the OS, which writes them to the file even when the process crashes.
+    class MappedFile {
+    public:
+        MappedFile()
+            : m_data{nullptr},
+              m_size{0},
+#if defined(NK_PLATFORM_WINDOWS)
+              m_file{INVALID_HANDLE_VALUE},
+              m_mapping{nullptr} {}
+#else
+              m_file{-1} {}
+#endif
+
+        ~MappedFile();
+
+        // Creates the file, or truncates it, at size_bytes of zeros.
+        bool open(cstr path, u64 size_bytes);
+        void close();
+
+        u8* data() const { return m_data; }
+        u64 size() const { return m_size; }
+
+    private:
+        u8* m_data;
+        u64 m_size;
+#if defined(NK_PLATFORM_WINDOWS)
+        HANDLE m_file;
+        HANDLE m_mapping;
+#else
+        i32 m_file;
+#endif
+    };
+}
@@ -14,6 +14,9 @@ namespace nk {
         virtual bool pump_messages() = 0;
         virtual f64 get_absolute_time() = 0;
         virtual void sleep(u64 ms) = 0;
+        // Called from the input sampling thread, pushes the device state that
+        // changed as InputSystem samples. Platforms without polling skip it.
+        virtual void sample_input() {}
 
         bool suspended() const { return m_suspended; }
         bool running() const { return m_running; }
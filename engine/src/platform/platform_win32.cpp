@@ -9,6 +9,12 @@
 namespace nk {
     LRESULT CALLBACK win32_process_message(HWND hwnd, u32 msg, WPARAM wparam, LPARAM lparam);
 
+    // Set by the sampling thread while the window is in the foreground and
+    // it reads the mouse, with the message time it started at. Mouse
+    // messages from before that are not covered by any sample.
+    static std::atomic<bool> sampler_covers_mouse = false;
+    static std::atomic<DWORD> sampler_covers_since_ms = 0;
+
     PlatformWin32::PlatformWin32(const ApplicationConfig& config)
         : Platform(config) {
         m_hinstance = GetModuleHandleA(0);
@@ -91,6 +97,9 @@ namespace nk {
         m_clock_frequency = 1.0f / static_cast<f64>(frequency.QuadPart);
         QueryPerformanceCounter(&m_start_time);
 
+        m_sampled_cursor = {};
+        memset(m_sampled_buttons, 0, sizeof(m_sampled_buttons));
+
         InfoLog("PlatformWin32 created.");
     }
 
@@ -120,7 +129,59 @@ namespace nk {
         Sleep(ms);
     }
 
+    void PlatformWin32::sample_input() {
+        if (GetForegroundWindow() != m_hwnd) {
+            sampler_covers_mouse.store(false, std::memory_order_release);
+            return;
+        }
+
+        // Samples read the live state, anything from this tick on is in them.
+        if (!sampler_covers_mouse.load(std::memory_order_relaxed)) {
+            sampler_covers_since_ms.store(GetTickCount(), std::memory_order_relaxed);
+            sampler_covers_mouse.store(true, std::memory_order_release);
+        }
+
+        const u64 timestamp = InputSystem::timestamp_ns();
+
+        POINT cursor;
+        if (GetCursorPos(&cursor) && ScreenToClient(m_hwnd, &cursor) &&
+            (cursor.x != m_sampled_cursor.x || cursor.y != m_sampled_cursor.y)) {
+            m_sampled_cursor = cursor;
+            InputSystem::push_sample({
+                .timestamp_ns = timestamp,
+                .kind = InputSystem::InputSample::Kind::MouseMove,
+                .x = static_cast<i16>(cursor.x),
+                .y = static_cast<i16>(cursor.y),
+            });
+        }
+
+        // Same order as MouseButton.
+        static constexpr int button_keys[] = {VK_LBUTTON, VK_RBUTTON, VK_MBUTTON};
+        for (u8 i = 0; i < static_cast<u8>(MouseButton::MaxButtons); i++) {
+            const bool pressed = (GetAsyncKeyState(button_keys[i]) & 0x8000) != 0;
+            if (pressed == m_sampled_buttons[i])
+                continue;
+
+            m_sampled_buttons[i] = pressed;
+            InputSystem::push_sample({
+                .timestamp_ns = timestamp,
+                .kind = InputSystem::InputSample::Kind::MouseButton,
+                .pressed = pressed,
+                .button = static_cast<MouseButton>(i),
+            });
+        }
+    }
+
     LRESULT CALLBACK win32_process_message(HWND hwnd, u32 msg, WPARAM wparam, LPARAM lparam) {
+        // The sampling thread owns the cursor and the buttons while it reads
+        // them, their messages are older than the samples and would undo
+        // them. Messages it did not see, like the click that brings the
+        // window to the foreground, still go through.
+        if (InputSystem::sampling() && (msg == WM_MOUSEMOVE || (msg >= WM_LBUTTONDOWN && msg <= WM_MBUTTONDBLCLK)) &&
+            sampler_covers_mouse.load(std::memory_order_acquire) &&
+            static_cast<LONG>(static_cast<DWORD>(GetMessageTime()) - sampler_covers_since_ms.load(std::memory_order_relaxed)) >= 0)
+            return DefWindowProcA(hwnd, msg, wparam, lparam);
+
         switch (msg) {
             case WM_ERASEBKGND:
                 // Notify the OS that erasing will be handled by the application to prevent flicker.
@@ -129,7 +190,7 @@ namespace nk {
                 PostQuitMessage(0);
                 return 0;
             case WM_CLOSE:
-                EventSystem::fire_event(SystemEventCode::ApplicationQuit, nullptr, EventContext{});
+                EventSystem::post_event(SystemEventCode::ApplicationQuit, nullptr, EventContext{});
                 return 0;
             case WM_SIZE: {
                 WINDOWPLACEMENT placement;
@@ -147,7 +208,7 @@ namespace nk {
                 EventContext context;
                 context.data.u32[0] = width;
                 context.data.u32[1] = height;
-                EventSystem::fire_event(SystemEventCode::Resized, nullptr, context);
+                EventSystem::post_event(SystemEventCode::Resized, nullptr, context);
             } break;
             case WM_ACTIVATEAPP: {
                 // if (wparam) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "platform/platform.h"
+#include "core/input_codes.h"
 
 namespace nk {
     class PlatformWin32 : public Platform {
@@ -11,6 +12,7 @@ namespace nk {
         virtual bool pump_messages() override;
         virtual f64 get_absolute_time() override;
         virtual void sleep(u64 ms) override;
+        virtual void sample_input() override;
 
         HINSTANCE get_hinstance() { return m_hinstance; }
         HWND get_hwnd() { return m_hwnd; }
@@ -21,5 +23,9 @@ namespace nk {
 
         f64 m_clock_frequency;
         LARGE_INTEGER m_start_time;
+
+        // Last state seen by sample_input, only touched by the sampling thread.
+        POINT m_sampled_cursor;
+        bool m_sampled_buttons[static_cast<u8>(MouseButton::MaxButtons)];
     };
 }
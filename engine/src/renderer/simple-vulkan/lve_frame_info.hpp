@@ -3,6 +3,8 @@
 #include "lve_camera.hpp"
 #include "lve_game_object.hpp"
 
+#include "collections/sparse_set.h"
+
 // lib
 #include <vulkan/vulkan.h>
 
@@ -31,5 +33,6 @@ struct FrameInfo {
   LveCamera &camera;
   VkDescriptorSet globalDescriptorSet;
   LveGameObject::Map &gameObjects;
+  nk::cl::sparse_set<LveGameObject::id_t> &pointLights;
 };
 }  // namespace lve
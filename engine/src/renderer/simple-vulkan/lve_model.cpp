@@ -5,8 +5,6 @@
 // libs
 #define TINYOBJLOADER_IMPLEMENTATION
 #include <tinyobjloader/tiny_obj_loader.h>
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/gtx/hash.hpp>
 
 // std
 #include <cassert>
@@ -21,9 +19,7 @@ namespace std {
 template <>
 struct hash<lve::LveModel::Vertex> {
   size_t operator()(lve::LveModel::Vertex const &vertex) const {
-    size_t seed = 0;
-    lve::hashCombine(seed, vertex.position, vertex.color, vertex.normal, vertex.uv);
-    return seed;
+    return lve::hashFloats(vertex.position, vertex.color, vertex.normal, vertex.uv);
   }
 };
 }  // namespace std
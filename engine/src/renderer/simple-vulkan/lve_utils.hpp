@@ -1,14 +1,34 @@
 #pragma once
 
+#include "core/hash.h"
+
+// libs
+#include <glm/glm.hpp>
+
+// std
 #include <functional>
 
 namespace lve {
 
-// from: https://stackoverflow.com/a/57595105
 template <typename T, typename... Rest>
 void hashCombine(std::size_t& seed, const T& v, const Rest&... rest) {
-  seed ^= std::hash<T>{}(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  seed = nk::hash::combine(seed, std::hash<T>{}(v));
   (hashCombine(seed, rest), ...);
 };
 
+// Hashes the components of glm float vectors in a single pass. -0.0f is folded
+// into 0.0f so vectors that compare equal always hash equal.
+template <typename... Vectors>
+std::size_t hashFloats(const Vectors&... vectors) {
+  float values[(Vectors::length() + ...)];
+  std::size_t count = 0;
+  auto append = [&](const auto& vector) {
+    for (glm::length_t i = 0; i < vector.length(); i++) {
+      values[count++] = vector[i] == 0.0f ? 0.0f : vector[i];
+    }
+  };
+  (append(vectors), ...);
+  return nk::hash::hash64(values, sizeof(values));
+}
+
 }  // namespace lve
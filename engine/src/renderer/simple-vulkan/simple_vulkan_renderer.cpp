@@ -28,6 +28,7 @@ namespace nk {
                             .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 100)
                             .build();
 
+        m_point_lights.sparse_set_init(m_allocator, MAX_LIGHTS);
         load_game_objects();
 
         m_ubo_buffers.resize(lve::LveSwapChain::MAX_FRAMES_IN_FLIGHT);
@@ -67,6 +68,7 @@ namespace nk {
     void SimpleVulkanRenderer::shutdown() {
         vkDeviceWaitIdle(m_device.device());
         free_command_buffers();
+        m_point_lights.sparse_set_shutdown();
     }
 
     bool SimpleVulkanRenderer::draw_frame(const RenderPacket& packet) {
@@ -88,7 +90,8 @@ namespace nk {
                 m_current_command_buffer,
                 m_camera,
                 m_global_descriptor_sets[frameIndex],
-                m_game_objects};
+                m_game_objects,
+                m_point_lights};
 
             // update
             lve::GlobalUbo ubo{};
@@ -322,6 +325,7 @@ namespace nk {
                 (i * glm::two_pi<float>()) / lightColors.size(),
                 {0.f, -1.f, 0.f});
             pointLight.transform.translation = glm::vec3(rotateLight * glm::vec4(-1.f, -1.f, -1.f, 1.f));
+            m_point_lights.sparse_set_insert(pointLight.getId());
             m_game_objects.emplace(pointLight.getId(), std::move(pointLight));
         }
     }
@@ -69,6 +69,7 @@ namespace nk {
         std::unique_ptr<lve::LveDescriptorPool> m_global_pool;
         std::unique_ptr<lve::LveDescriptorPool> m_texture_pool;
         lve::LveGameObject::Map m_game_objects;
+        cl::sparse_set<lve::LveGameObject::id_t> m_point_lights;
 
         std::vector<std::unique_ptr<lve::LveBuffer>> m_ubo_buffers;
         std::unique_ptr<lve::LveDescriptorSetLayout> m_global_set_layout;
@@ -1,5 +1,7 @@
 #include "point_light_system.hpp"
 
+#include "collections/sort.h"
+
 // libs
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -9,7 +11,6 @@
 // std
 #include <array>
 #include <cassert>
-#include <map>
 #include <stdexcept>
 
 namespace lve {
@@ -71,9 +72,8 @@ void PointLightSystem::createPipeline(VkRenderPass renderPass) {
 void PointLightSystem::update(FrameInfo& frameInfo, GlobalUbo& ubo) {
   auto rotateLight = glm::rotate(glm::mat4(1.f), 0.5f * frameInfo.frameTime, {0.f, -1.f, 0.f});
   int lightIndex = 0;
-  for (auto& kv : frameInfo.gameObjects) {
-    auto& obj = kv.second;
-    if (obj.pointLight == nullptr) continue;
+  for (auto id : frameInfo.pointLights) {
+    auto& obj = frameInfo.gameObjects.at(id);
 
     assert(lightIndex < MAX_LIGHTS && "Point lights exceed maximum specified");
 
@@ -90,17 +90,24 @@ void PointLightSystem::update(FrameInfo& frameInfo, GlobalUbo& ubo) {
 }
 
 void PointLightSystem::render(FrameInfo& frameInfo) {
-  // sort lights
-  std::map<float, LveGameObject::id_t> sorted;
-  for (auto& kv : frameInfo.gameObjects) {
-    auto& obj = kv.second;
-    if (obj.pointLight == nullptr) continue;
+  // sort lights, scratch lives on the stack so nothing is allocated per frame
+  float distances[MAX_LIGHTS];
+  LveGameObject::id_t ids[MAX_LIGHTS];
+  float scratchDistances[MAX_LIGHTS];
+  LveGameObject::id_t scratchIds[MAX_LIGHTS];
+  nk::u64 lightCount = 0;
+  for (auto id : frameInfo.pointLights) {
+    auto& obj = frameInfo.gameObjects.at(id);
+
+    assert(lightCount < MAX_LIGHTS && "Point lights exceed maximum specified");
 
     // calculate distance
     auto offset = frameInfo.camera.getPosition() - obj.transform.translation;
-    float disSquared = glm::dot(offset, offset);
-    sorted[disSquared] = obj.getId();
+    distances[lightCount] = glm::dot(offset, offset);
+    ids[lightCount] = obj.getId();
+    lightCount += 1;
   }
+  nk::cl::radix_sort_pairs_scratch(distances, ids, lightCount, scratchDistances, scratchIds);
 
   lvePipeline->bind(frameInfo.commandBuffer);
 
@@ -115,9 +122,9 @@ void PointLightSystem::render(FrameInfo& frameInfo) {
       nullptr);
 
   // iterate through sorted lights in reverse order
-  for (auto it = sorted.rbegin(); it != sorted.rend(); ++it) {
+  for (nk::u64 i = lightCount; i > 0; --i) {
     // use game obj id to find light object
-    auto& obj = frameInfo.gameObjects.at(it->second);
+    auto& obj = frameInfo.gameObjects.at(ids[i - 1]);
 
     PointLightPushConstants push{};
     push.position = glm::vec4(obj.transform.translation, 1.f);
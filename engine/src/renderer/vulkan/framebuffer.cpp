@@ -13,14 +13,14 @@ namespace nk {
           m_framebuffer{other.m_framebuffer},
           m_width{other.m_width},
           m_height{other.m_height},
-          m_attachments{std::move(other.m_attachments)} {
+          m_attachments{other.m_attachments} {
         other.m_vulkan_allocator = nullptr;
         other.m_device = nullptr;
         other.m_allocator = nullptr;
         other.m_framebuffer = nullptr;
         other.m_width = 0;
         other.m_height = 0;
-        other.m_attachments.arr_reset();
+        other.m_attachments.static_arr_reset();
     }
 
     Framebuffer& Framebuffer::operator=(Framebuffer&& other) {
@@ -30,7 +30,7 @@ namespace nk {
         m_framebuffer = other.m_framebuffer;
         m_width = other.m_width;
         m_height = other.m_height;
-        m_attachments = std::move(other.m_attachments);
+        m_attachments = other.m_attachments;
 
         other.m_vulkan_allocator = nullptr;
         other.m_device = nullptr;
@@ -38,20 +38,21 @@ namespace nk {
         other.m_framebuffer = nullptr;
         other.m_width = 0;
         other.m_height = 0;
-        other.m_attachments.arr_reset();
+        other.m_attachments.static_arr_reset();
 
         return *this;
     }
 
     void Framebuffer::init(const u32 width,
                            const u32 height,
-                           cl::arr<VkImageView>& attachments,
+                           cl::view<const VkImageView> attachments,
                            Device* device,
                            RenderPass& render_pass,
                            VkAllocationCallbacks* vulkan_allocator) {
         m_width = width;
         m_height = height;
-        m_attachments = std::move(attachments);
+        m_attachments.static_arr_reset();
+        m_attachments.static_arr_push_range(attachments.data(), attachments.length());
         m_device = device;
         m_vulkan_allocator = vulkan_allocator;
 
@@ -73,12 +74,12 @@ namespace nk {
             vkDestroyFramebuffer(m_device->get(), m_framebuffer, m_vulkan_allocator);
             m_framebuffer = nullptr;
         }
-        m_attachments.arr_shutdown();
+        m_attachments.static_arr_reset();
     }
 
     void Framebuffer::renew(const u32 width,
                             const u32 height,
-                            cl::arr<VkImageView>& attachments,
+                            cl::view<const VkImageView> attachments,
                             Device* device,
                             RenderPass& render_pass,
                             VkAllocationCallbacks* vulkan_allocator) {
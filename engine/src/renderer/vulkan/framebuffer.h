@@ -1,7 +1,8 @@
 #pragma once
 
 #include "vulkan/vk.h"
-#include "collections/arr.h"
+#include "collections/static_arr.h"
+#include "collections/view.h"
 
 namespace nk {
     namespace mem {
@@ -13,6 +14,8 @@ namespace nk {
 
     class Framebuffer {
     public:
+        static constexpr u64 max_attachments = 8;
+
         Framebuffer() = default;
         ~Framebuffer() { shutdown(); }
 
@@ -24,7 +27,7 @@ namespace nk {
 
         void init(const u32 width,
                   const u32 height,
-                  cl::arr<VkImageView>& attachments,
+                  cl::view<const VkImageView> attachments,
                   Device* device,
                   RenderPass& render_pass,
                   VkAllocationCallbacks* vulkan_allocator);
@@ -32,7 +35,7 @@ namespace nk {
 
         void renew(const u32 width,
                    const u32 height,
-                   cl::arr<VkImageView>& attachments,
+                   cl::view<const VkImageView> attachments,
                    Device* device,
                    RenderPass& render_pass,
                    VkAllocationCallbacks* vulkan_allocator);
@@ -52,6 +55,6 @@ namespace nk {
         VkFramebuffer m_framebuffer;
         u32 m_width;
         u32 m_height;
-        cl::arr<VkImageView> m_attachments;
+        cl::static_arr<VkImageView, max_attachments> m_attachments;
     };
 }
@@ -20,10 +20,10 @@ namespace nk {
                 WarnLog(callback_data->pMessage);
                 break;
             case VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT:
-                InfoLog(callback_data->pMessage);
+                InfoLog("{}", callback_data->pMessage);
                 break;
             case VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT:
-                TraceLog(callback_data->pMessage);
+                TraceLog("{}", callback_data->pMessage);
                 break;
         }
         return VK_FALSE;
@@ -82,7 +82,7 @@ namespace nk {
             debug_extensions += m_extensions[i];
             debug_extensions += "\n";
         }
-        DebugLog(debug_extensions);
+        DebugLog("{}", debug_extensions);
 #endif
 
         instance_create_info.enabledExtensionCount = static_cast<u32>(m_extensions.length());
@@ -449,13 +449,10 @@ namespace nk {
         }
 
         for (u32 i = 0; i < m_framebuffers.length(); i++) {
-            cl::arr<VkImageView> attachments;
-            // clang-format off
-            attachments.arr_init_list(m_allocator, {
+            VkImageView attachments[] = {
                 m_swapchain.get_image_view_at(i),
                 m_swapchain.get_depth_attachment()->get_view(),
-            });
-            // clang-format on
+            };
             m_framebuffers[i].renew(
                 m_framebuffer_width,
                 m_framebuffer_height,
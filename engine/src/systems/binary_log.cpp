@@ -0,0 +1,302 @@
+#include "nkpch.h"
+
+#include "systems/binary_log.h"
+#include "platform/file.h"
+
+namespace nk::binary_log {
+    struct DecodedArgument {
+        LogArgument type;
+        u64 bits;
+        std::string_view string;
+    };
+}
+
+// Formats a decoded argument with the spec of its replacement field, as the
+// original value would have been.
+template <>
+struct std::formatter<nk::binary_log::DecodedArgument> {
+    std::string_view spec;
+
+    constexpr auto parse(std::format_parse_context& context) {
+        auto it = context.begin();
+        while (it != context.end() && *it != '}') {
+            ++it;
+        }
+        spec = std::string_view(context.begin(), it);
+        return it;
+    }
+
+    auto format(const nk::binary_log::DecodedArgument& argument, std::format_context& context) const {
+        char buffer[64] = "{:";
+        const nk::u64 size = spec.size() < sizeof(buffer) - 4 ? spec.size() : sizeof(buffer) - 4;
+        std::memcpy(buffer + 2, spec.data(), size);
+        buffer[2 + size] = '}';
+        const std::string_view format(buffer, 3 + size);
+
+        switch (argument.type) {
+            case nk::LogArgument::I64: {
+                const nk::i64 value = static_cast<nk::i64>(argument.bits);
+                return std::vformat_to(context.out(), format, std::make_format_args(value));
+            }
+            case nk::LogArgument::U64: {
+                const nk::u64 value = argument.bits;
+                return std::vformat_to(context.out(), format, std::make_format_args(value));
+            }
+            case nk::LogArgument::F32: {
+                nk::f32 value;
+                std::memcpy(&value, &argument.bits, sizeof(value));
+                return std::vformat_to(context.out(), format, std::make_format_args(value));
+            }
+            case nk::LogArgument::F64: {
+                nk::f64 value;
+                std::memcpy(&value, &argument.bits, sizeof(value));
+                return std::vformat_to(context.out(), format, std::make_format_args(value));
+            }
+            case nk::LogArgument::Bool: {
+                const bool value = argument.bits != 0;
+                return std::vformat_to(context.out(), format, std::make_format_args(value));
+            }
+            case nk::LogArgument::Char: {
+                const char value = static_cast<char>(argument.bits);
+                return std::vformat_to(context.out(), format, std::make_format_args(value));
+            }
+            case nk::LogArgument::String: {
+                const std::string_view value = argument.string;
+                return std::vformat_to(context.out(), format, std::make_format_args(value));
+            }
+            case nk::LogArgument::Pointer: {
+                const void* value = reinterpret_cast<const void*>(static_cast<std::uintptr_t>(argument.bits));
+                return std::vformat_to(context.out(), format, std::make_format_args(value));
+            }
+        }
+
+        return context.out();
+    }
+};
+
+namespace nk::binary_log {
+    bool format_arguments(std::string_view format, const u8* arguments, u64 size_bytes, std::string& out) {
+        // A line without arguments is its text as is, as on the text path.
+        if (size_bytes == 0) {
+            out.append(format);
+            return true;
+        }
+
+        DecodedArgument decoded[LoggingSystem::max_binary_arguments] = {};
+        u64 offset = 0;
+        for (u64 i = 0; i < LoggingSystem::max_binary_arguments && offset < size_bytes; i++) {
+            DecodedArgument& argument = decoded[i];
+            argument.type = static_cast<LogArgument>(arguments[offset++]);
+
+            // Each read is checked, a torn or cut off record stops here.
+            u64 needed = sizeof(argument.bits);
+            if (argument.type == LogArgument::String) {
+                u32 length = 0;
+                if (size_bytes - offset >= sizeof(length)) {
+                    std::memcpy(&length, arguments + offset, sizeof(length));
+                }
+                needed = sizeof(length) + static_cast<u64>(length);
+            }
+
+            if (argument.type > LogArgument::F32 || size_bytes - offset < needed) {
+                out.append(corrupt_record);
+                return false;
+            }
+
+            if (argument.type == LogArgument::String) {
+                argument.string = std::string_view(reinterpret_cast<const char*>(arguments + offset + sizeof(u32)), needed - sizeof(u32));
+            } else {
+                std::memcpy(&argument.bits, arguments + offset, sizeof(argument.bits));
+            }
+            offset += needed;
+        }
+
+        // Unused trailing arguments are ignored by the format.
+        auto& [a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15] = decoded;
+        std::vformat_to(std::back_inserter(out), format,
+                        std::make_format_args(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15));
+        return true;
+    }
+
+    static void append_entry(std::string& out, const Entry& entry, std::string_view first, std::string_view second) {
+        out.append(reinterpret_cast<const char*>(&entry), sizeof(Entry));
+        out.append(first);
+        out.append(second);
+    }
+
+    void append_site(std::string& out, u32 id, const LogSite& site) {
+        append_entry(out,
+                     Entry{
+                         .size = static_cast<u32>(sizeof(Entry) + site.format.size() + site.file.size()),
+                         .kind = EntryKind::Site,
+                         .level = site.level,
+                         .reserved = 0,
+                         .id = id,
+                         .line = site.line,
+                         .timestamp_ns = 0,
+                         .text_size = static_cast<u32>(site.format.size()),
+                         .file_size = static_cast<u32>(site.file.size()),
+                     },
+                     site.format, site.file);
+    }
+
+    void append_record(std::string& out, u32 id, LoggingLevel level, i64 timestamp_ns, const u8* arguments, u64 size_bytes) {
+        append_entry(out,
+                     Entry{
+                         .size = static_cast<u32>(sizeof(Entry) + size_bytes),
+                         .kind = EntryKind::Record,
+                         .level = level,
+                         .reserved = 0,
+                         .id = id,
+                         .line = 0,
+                         .timestamp_ns = timestamp_ns,
+                         .text_size = 0,
+                         .file_size = 0,
+                     },
+                     std::string_view(reinterpret_cast<const char*>(arguments), size_bytes), {});
+    }
+
+    void append_text(std::string& out, LoggingLevel level, i64 timestamp_ns, std::string_view file, u32 line, std::string_view message) {
+        append_entry(out,
+                     Entry{
+                         .size = static_cast<u32>(sizeof(Entry) + message.size() + file.size()),
+                         .kind = EntryKind::Text,
+                         .level = level,
+                         .reserved = 0,
+                         .id = 0,
+                         .line = line,
+                         .timestamp_ns = timestamp_ns,
+                         .text_size = static_cast<u32>(message.size()),
+                         .file_size = static_cast<u32>(file.size()),
+                     },
+                     message, file);
+    }
+
+    static void append_line(std::string& out, LoggingLevel level, i64 timestamp_ns, std::string_view message, std::string_view file, u32 line) {
+        const std::time_t time = static_cast<std::time_t>(timestamp_ns / 1'000'000'000);
+        const std::tm* tm = std::localtime(&time);
+        std::format_to(std::back_inserter(out), "{:02}:{:02}:{:02}.{:03}", tm->tm_hour, tm->tm_min, tm->tm_sec, (timestamp_ns / 1'000'000) % 1000);
+        out.append(LoggingSystem::level_prefix(level));
+        out.append(message);
+        std::format_to(std::back_inserter(out), " ({}:{})\n", file, line);
+    }
+
+    // Walks the entries, false as soon as one does not fit the stream.
+    template <typename Callback>
+    static bool for_each_entry(const u8* data, u64 size_bytes, Callback&& callback) {
+        u64 offset = 0;
+        while (offset + sizeof(Entry) <= size_bytes) {
+            Entry entry;
+            std::memcpy(&entry, data + offset, sizeof(Entry));
+            if (entry.size < sizeof(Entry) || offset + entry.size > size_bytes)
+                return false;
+
+            const char* payload = reinterpret_cast<const char*>(data + offset + sizeof(Entry));
+            const u64 payload_size = entry.size - sizeof(Entry);
+            if (entry.kind != EntryKind::Record && entry.text_size + entry.file_size > payload_size)
+                return false;
+
+            if (!callback(entry, payload, payload_size))
+                return false;
+
+            offset += entry.size;
+        }
+
+        return offset == size_bytes;
+    }
+
+    bool decode(const u8* data, u64 size_bytes, std::string& out) {
+        struct DecodedSite {
+            std::string_view format;
+            std::string_view file;
+            u32 line;
+            bool seen;
+        };
+
+        // Ids are dense, a stream can not hold more sites than entries fit in
+        // it. A larger id is corrupt and would size the table after it.
+        const u64 max_sites = size_bytes / sizeof(Entry);
+        u32 site_count = 0;
+        const bool valid = for_each_entry(data, size_bytes, [&](const Entry& entry, const char*, u64) {
+            if (entry.kind == EntryKind::Site && entry.id >= site_count) {
+                if (entry.id >= max_sites)
+                    return false;
+                site_count = entry.id + 1;
+            }
+            return true;
+        });
+
+        DecodedSite* sites = site_count > 0 ? native_allocate_lot(DecodedSite, site_count) : nullptr;
+        for (u32 i = 0; i < site_count; i++) {
+            sites[i].seen = false;
+        }
+
+        std::string message;
+        const bool decoded = for_each_entry(data, size_bytes, [&](const Entry& entry, const char* payload, u64 payload_size) {
+            switch (entry.kind) {
+                case EntryKind::Site:
+                    if (entry.id >= site_count)
+                        return false;
+
+                    sites[entry.id] = {
+                        .format = std::string_view(payload, entry.text_size),
+                        .file = std::string_view(payload + entry.text_size, entry.file_size),
+                        .line = entry.line,
+                        .seen = true,
+                    };
+                    return true;
+                case EntryKind::Record: {
+                    // A site always comes before its first record.
+                    if (entry.id >= site_count || !sites[entry.id].seen)
+                        return false;
+
+                    const DecodedSite& site = sites[entry.id];
+                    message.clear();
+                    format_arguments(site.format, reinterpret_cast<const u8*>(payload), payload_size, message);
+                    append_line(out, entry.level, entry.timestamp_ns, message, site.file, site.line);
+                    return true;
+                }
+                case EntryKind::Text:
+                    append_line(out, entry.level, entry.timestamp_ns, std::string_view(payload, entry.text_size),
+                                std::string_view(payload + entry.text_size, entry.file_size), entry.line);
+                    return true;
+                case EntryKind::Padding:
+                    break;
+            }
+            return false;
+        });
+
+        if (sites != nullptr) {
+            native_free_lot(DecodedSite, sites, site_count);
+        }
+
+        return valid && decoded;
+    }
+
+    bool decode_file(cstr path, std::string& out) {
+        File file;
+        if (!file.open(path, FileMode::Read, true))
+            return false;
+
+        u8* data = nullptr;
+        u64 size_bytes = 0;
+        const bool read = file.read_all_bytes(&data, &size_bytes);
+
+        FileHeader header = {};
+        if (read && size_bytes >= sizeof(FileHeader)) {
+            std::memcpy(&header, data, sizeof(FileHeader));
+        }
+
+        bool decoded = false;
+        if (header.magic != file_magic || header.version != file_version || header.entry_size != sizeof(Entry)) {
+            ErrorLog("nk::binary_log::decode_file {} is not a binary log of version {}.", path, file_version);
+        } else {
+            decoded = decode(data + sizeof(FileHeader), size_bytes - sizeof(FileHeader), out);
+        }
+
+        if (data != nullptr) {
+            native_free_lot(u8, data, size_bytes);
+        }
+        return decoded;
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+namespace nk::binary_log {
+    // A binary log is a FileHeader and a stream of entries. Sites describe a
+    // call site once, records reference one by id with their encoded
+    // arguments, text entries hold an already formatted line.
+    enum class EntryKind : u8 {
+        // Only in a flight recorder ring, the unused end before it wraps.
+        Padding = 0,
+        Site,
+        Record,
+        Text,
+    };
+
+    struct FileHeader {
+        u32 magic;
+        u16 version;
+        u16 entry_size;
+    };
+
+    // Site: format then file follow. Record: the arguments, up to size.
+    // Text: message then file.
+    struct Entry {
+        u32 size;
+        EntryKind kind;
+        LoggingLevel level;
+        u16 reserved;
+        u32 id;
+        u32 line;
+        i64 timestamp_ns;
+        u32 text_size;
+        u32 file_size;
+    };
+
+    static constexpr u32 file_magic = 0x424C4B4E; // "NKLB"
+    static constexpr u16 file_version = 1;
+
+    static constexpr std::string_view corrupt_record = "<corrupt record>";
+
+    // Formats a binary line, the format alone when it has no arguments like
+    // the text path does. False, with corrupt_record appended, when the
+    // arguments do not fit size_bytes or have an unknown tag.
+    bool format_arguments(std::string_view format, const u8* arguments, u64 size_bytes, std::string& out);
+
+    // Appends entries to out, sites are written by the caller.
+    void append_site(std::string& out, u32 id, const LogSite& site);
+    void append_record(std::string& out, u32 id, LoggingLevel level, i64 timestamp_ns, const u8* arguments, u64 size_bytes);
+    void append_text(std::string& out, LoggingLevel level, i64 timestamp_ns, std::string_view file, u32 line, std::string_view message);
+
+    // Turns a stream of entries back into lines of "time [Level]: message
+    // (file:line)". Returns false on a malformed stream, with the lines
+    // decoded up to it.
+    bool decode(const u8* data, u64 size_bytes, std::string& out);
+    bool decode_file(cstr path, std::string& out);
+}
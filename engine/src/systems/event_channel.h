@@ -0,0 +1,264 @@
+#pragma once
+
+#include "systems/event_system.h"
+
+namespace nk {
+    // Payload types carry their own channel id, usually a hash of their name:
+    //     struct AssetLoaded {
+    //         static constexpr u64 channel_id = hash::string("AssetLoaded");
+    //         ...
+    //     };
+    // Payloads live in the frame arena and are dropped without running any
+    // destructor, so they must be trivially destructible.
+    template <typename T>
+    concept IEventPayload = std::is_trivially_destructible_v<T> &&
+                            std::is_copy_constructible_v<T> &&
+                            requires {
+                                { T::channel_id } -> std::convertible_to<u64>;
+                            };
+
+    class EventChannelBase {
+    public:
+        virtual ~EventChannelBase() = default;
+
+        virtual u64 channel_id() const = 0;
+
+    protected:
+        // Delivers and forgets everything posted into the given arena buffer.
+        virtual void dispatch(u8 buffer) = 0;
+        virtual void shutdown() = 0;
+
+        static mem::Allocator* allocator();
+        static void add_channel(EventChannelBase* channel);
+        static void* allocate_payload(u64 size_bytes, u64 alignment);
+        // Buffer that posts go into until the next dispatch.
+        static u8 posting_buffer();
+
+        friend class EventSystem;
+    };
+
+    // Typed, unbounded counterpart of post_event/fire_event. post copies the
+    // payload once into the frame arena of EventSystem and the next
+    // EventSystem::dispatch hands listeners a const reference to it, the
+    // arena is then reset in bulk. Main thread only.
+    template <IEventPayload T>
+    class EventChannel : public EventChannelBase {
+    public:
+        using PFN_OnPayload = bool (*)(const T& payload, void* listener);
+
+        static constexpr u64 id = T::channel_id;
+
+        ~EventChannel() = default;
+
+        static EventChannel& get() {
+            static EventChannel instance;
+            return instance;
+        }
+
+        // Same ordering rules as EventSystem::register_event.
+        static EventHandle register_listener(void* listener, PFN_OnPayload callback, i32 priority = 0);
+        static bool unregister_listener(EventHandle handle);
+        static bool is_registered(EventHandle handle);
+
+        template <typename... Args>
+        static const T& post(Args&&... args);
+
+        // Calls the listeners right away, nothing goes through the arena.
+        static bool fire(const T& payload);
+
+        static u64 queued_count() {
+            EventChannel& instance = get();
+            return instance.m_active ? instance.m_pending[posting_buffer()].length() : 0;
+        }
+
+        virtual u64 channel_id() const override { return id; }
+
+    private:
+        struct Listener {
+            void* listener;
+            PFN_OnPayload callback;
+            i32 priority;
+            u32 order;
+            u32 subscription;
+        };
+
+        struct Subscription {
+            u32 position;
+            u32 generation;
+            bool active;
+        };
+
+        static constexpr u32 none = std::numeric_limits<u32>::max();
+
+        EventChannel() = default;
+
+        void activate();
+        void sort_listeners();
+        bool deliver(const T& payload);
+
+        virtual void dispatch(u8 buffer) override;
+        virtual void shutdown() override;
+
+        cl::dyarr<Listener> m_listeners;
+        cl::dyarr<Subscription> m_subscriptions;
+        cl::dyarr<const T*> m_pending[2];
+        u32 m_free_subscription = none;
+        u32 m_next_order = 0;
+        bool m_unsorted = false;
+        bool m_active = false;
+    };
+
+    template <IEventPayload T>
+    EventHandle EventChannel<T>::register_listener(void* listener, PFN_OnPayload callback, i32 priority) {
+        EventChannel& instance = get();
+        instance.activate();
+
+        u32 index = instance.m_free_subscription;
+        if (index != none) {
+            instance.m_free_subscription = instance.m_subscriptions[index].position;
+        } else {
+            index = static_cast<u32>(instance.m_subscriptions.length());
+            instance.m_subscriptions.dyarr_push_copy(Subscription{.generation = 0});
+        }
+
+        if (!instance.m_listeners.empty() && instance.m_listeners.dyarr_last().priority < priority) {
+            instance.m_unsorted = true;
+        }
+
+        Subscription& subscription = instance.m_subscriptions[index];
+        subscription.position = static_cast<u32>(instance.m_listeners.length());
+        subscription.active = true;
+
+        instance.m_listeners.dyarr_push_copy(Listener{
+            .listener = listener,
+            .callback = callback,
+            .priority = priority,
+            .order = instance.m_next_order++,
+            .subscription = index,
+        });
+
+        return EventHandle{
+            .index = index,
+            .generation = subscription.generation,
+        };
+    }
+
+    template <IEventPayload T>
+    bool EventChannel<T>::unregister_listener(EventHandle handle) {
+        if (!is_registered(handle))
+            return false;
+
+        EventChannel& instance = get();
+        Subscription& subscription = instance.m_subscriptions[handle.index];
+
+        const u32 position = subscription.position;
+        instance.m_listeners.dyarr_swap_remove(position);
+        if (position < instance.m_listeners.length()) {
+            instance.m_subscriptions[instance.m_listeners[position].subscription].position = position;
+            instance.m_unsorted = true;
+        }
+
+        subscription.active = false;
+        subscription.generation++;
+        subscription.position = instance.m_free_subscription;
+        instance.m_free_subscription = handle.index;
+        return true;
+    }
+
+    template <IEventPayload T>
+    bool EventChannel<T>::is_registered(EventHandle handle) {
+        EventChannel& instance = get();
+
+        if (!instance.m_active || handle.index >= instance.m_subscriptions.length())
+            return false;
+
+        const Subscription& subscription = instance.m_subscriptions[handle.index];
+        return subscription.active && subscription.generation == handle.generation;
+    }
+
+    template <IEventPayload T>
+    template <typename... Args>
+    const T& EventChannel<T>::post(Args&&... args) {
+        EventChannel& instance = get();
+        Assert(EventSystem::is_main_thread(), "nk::EventChannel::post Must be called from the main thread!");
+        instance.activate();
+
+        T* payload = new (allocate_payload(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        instance.m_pending[posting_buffer()].dyarr_push_ptr(payload);
+        return *payload;
+    }
+
+    template <IEventPayload T>
+    bool EventChannel<T>::fire(const T& payload) {
+        EventChannel& instance = get();
+        if (!instance.m_active)
+            return false;
+        return instance.deliver(payload);
+    }
+
+    template <IEventPayload T>
+    void EventChannel<T>::activate() {
+        if (m_active)
+            return;
+
+        m_listeners.dyarr_init(allocator(), 4);
+        m_subscriptions.dyarr_init(allocator(), 4);
+        m_pending[0].dyarr_init(allocator(), 16);
+        m_pending[1].dyarr_init(allocator(), 16);
+        m_free_subscription = none;
+        m_next_order = 0;
+        m_unsorted = false;
+        m_active = true;
+
+        add_channel(this);
+    }
+
+    template <IEventPayload T>
+    void EventChannel<T>::sort_listeners() {
+        for (u64 i = 1; i < m_listeners.length(); i++) {
+            const Listener listener = m_listeners[i];
+            u64 j = i;
+            while (j > 0 && (m_listeners[j - 1].priority < listener.priority ||
+                             (m_listeners[j - 1].priority == listener.priority && m_listeners[j - 1].order > listener.order))) {
+                m_listeners[j] = m_listeners[j - 1];
+                j--;
+            }
+            m_listeners[j] = listener;
+        }
+
+        for (u64 i = 0; i < m_listeners.length(); i++) {
+            m_subscriptions[m_listeners[i].subscription].position = static_cast<u32>(i);
+        }
+        m_unsorted = false;
+    }
+
+    template <IEventPayload T>
+    bool EventChannel<T>::deliver(const T& payload) {
+        if (m_unsorted)
+            sort_listeners();
+
+        for (u64 i = 0; i < m_listeners.length(); i++) {
+            if (m_listeners[i].callback(payload, m_listeners[i].listener))
+                return true;
+        }
+        return false;
+    }
+
+    template <IEventPayload T>
+    void EventChannel<T>::dispatch(u8 buffer) {
+        cl::dyarr<const T*>& pending = m_pending[buffer];
+        for (u64 i = 0; i < pending.length(); i++) {
+            deliver(*pending[i]);
+        }
+        pending.dyarr_reset();
+    }
+
+    template <IEventPayload T>
+    void EventChannel<T>::shutdown() {
+        m_listeners.dyarr_shutdown();
+        m_subscriptions.dyarr_shutdown();
+        m_pending[0].dyarr_shutdown();
+        m_pending[1].dyarr_shutdown();
+        m_active = false;
+    }
+}
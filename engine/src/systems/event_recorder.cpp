@@ -0,0 +1,215 @@
+#include "nkpch.h"
+
+#include "systems/event_recorder.h"
+#include "systems/input_system.h"
+#include "memory/malloc_allocator.h"
+#include "platform/file.h"
+
+namespace nk {
+    EventRecorder& EventRecorder::init() {
+        EventRecorder& instance = get();
+
+        instance.m_allocator = native_construct(mem::MallocAllocator);
+        instance.m_allocator->allocator_init(mem::MallocAllocator, "EventRecorder", MemoryType::Event);
+
+        instance.m_events.dyarr_init(instance.m_allocator, 1024);
+        instance.m_fixed_delta = default_fixed_delta;
+        instance.m_cursor = 0;
+        instance.m_frame = 0;
+        instance.m_frame_count = 0;
+        instance.m_mode = Mode::Idle;
+        instance.m_capturing = false;
+        instance.m_injecting = false;
+
+        TraceLog("nk::EventRecorder Initialized.");
+        return instance;
+    }
+
+    void EventRecorder::shutdown() {
+        EventRecorder& instance = get();
+
+        if (instance.m_mode == Mode::Recording) {
+            stop_recording();
+        } else if (instance.m_mode == Mode::Replaying) {
+            stop_replay();
+        }
+
+        instance.m_events.dyarr_shutdown();
+        instance.m_path.clear();
+        native_deconstruct(mem::MallocAllocator, instance.m_allocator);
+        TraceLog("nk::EventRecorder Shutdown.");
+    }
+
+    bool EventRecorder::start_recording(cstr path) {
+        EventRecorder& instance = get();
+
+        if (instance.m_mode != Mode::Idle) {
+            WarnLog("nk::EventRecorder::start_recording Already recording or replaying.");
+            return false;
+        }
+
+        instance.m_events.dyarr_reset();
+        instance.m_path = path;
+        instance.m_start = std::chrono::steady_clock::now();
+        instance.m_frame = 0;
+        instance.m_mode = Mode::Recording;
+
+        InfoLog("nk::EventRecorder Recording events to {}.", path);
+        return true;
+    }
+
+    bool EventRecorder::stop_recording() {
+        EventRecorder& instance = get();
+
+        if (instance.m_mode != Mode::Recording)
+            return false;
+
+        instance.m_mode = Mode::Idle;
+
+        const FileHeader header = {
+            .magic = file_magic,
+            .version = file_version,
+            .record_size = sizeof(RecordedEvent),
+            .frame_count = instance.m_frame,
+            .event_count = static_cast<u32>(instance.m_events.length()),
+        };
+
+        File file;
+        if (!file.open(instance.m_path.c_str(), FileMode::Write, true))
+            return false;
+
+        u64 written;
+        if (!file.write(sizeof(FileHeader), &header, &written) ||
+            !file.write(instance.m_events.length() * sizeof(RecordedEvent), instance.m_events.data(), &written)) {
+            ErrorLog("nk::EventRecorder::stop_recording Failed to write {}.", instance.m_path);
+            return false;
+        }
+
+        InfoLog("nk::EventRecorder Recorded {} events over {} frames.", header.event_count, header.frame_count);
+        return true;
+    }
+
+    bool EventRecorder::start_replay(cstr path, f64 fixed_delta) {
+        EventRecorder& instance = get();
+
+        if (instance.m_mode != Mode::Idle) {
+            WarnLog("nk::EventRecorder::start_replay Already recording or replaying.");
+            return false;
+        }
+
+        File file;
+        if (!file.open(path, FileMode::Read, true))
+            return false;
+
+        FileHeader header;
+        u64 read;
+        if (!file.read(sizeof(FileHeader), &header, &read) || header.magic != file_magic) {
+            ErrorLog("nk::EventRecorder::start_replay {} is not an event recording.", path);
+            return false;
+        }
+
+        if (header.version != file_version || header.record_size != sizeof(RecordedEvent)) {
+            ErrorLog("nk::EventRecorder::start_replay {} has version {}, expected {}.", path, header.version, file_version);
+            return false;
+        }
+
+        instance.m_events.dyarr_resize(header.event_count);
+        if (!file.read(header.event_count * sizeof(RecordedEvent), instance.m_events.data(), &read)) {
+            ErrorLog("nk::EventRecorder::start_replay {} is truncated.", path);
+            instance.m_events.dyarr_reset();
+            return false;
+        }
+
+        instance.m_path = path;
+        instance.m_fixed_delta = fixed_delta;
+        instance.m_cursor = 0;
+        instance.m_frame = 0;
+        instance.m_frame_count = header.frame_count;
+        instance.m_mode = Mode::Replaying;
+
+        InfoLog("nk::EventRecorder Replaying {} events over {} frames from {}.", header.event_count, header.frame_count, path);
+        return true;
+    }
+
+    void EventRecorder::stop_replay() {
+        EventRecorder& instance = get();
+
+        if (instance.m_mode != Mode::Replaying)
+            return;
+
+        instance.m_mode = Mode::Idle;
+        instance.m_events.dyarr_reset();
+        instance.m_cursor = 0;
+    }
+
+    void EventRecorder::end_capture_impl() {
+        m_capturing = false;
+
+        if (m_mode == Mode::Recording) {
+            m_frame++;
+            return;
+        }
+
+        if (m_mode != Mode::Replaying)
+            return;
+
+        m_injecting = true;
+        while (m_cursor < m_events.length() && m_events[m_cursor].frame <= m_frame) {
+            inject(m_events[m_cursor++]);
+        }
+        m_injecting = false;
+
+        m_frame++;
+        if (m_frame >= m_frame_count) {
+            InfoLog("nk::EventRecorder Replay finished after {} frames.", m_frame);
+            stop_replay();
+            EventSystem::post_event(SystemEventCode::ApplicationQuit, nullptr, EventContext{});
+        }
+    }
+
+    bool EventRecorder::capture_impl(SystemEventCode code, const EventContext& context) {
+        if (!m_capturing || m_injecting)
+            return true;
+
+        if (m_mode == Mode::Recording) {
+            m_events.dyarr_push_copy(RecordedEvent{
+                .timestamp_ns = static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count()),
+                .frame = m_frame,
+                .code = static_cast<u16>(code),
+                .reserved = 0,
+                .context = context,
+            });
+            return true;
+        }
+
+        // The user can still close the window in the middle of a replay.
+        return m_mode != Mode::Replaying || code == SystemEventCode::ApplicationQuit;
+    }
+
+    void EventRecorder::inject(const RecordedEvent& event) {
+        const SystemEventCode code = static_cast<SystemEventCode>(event.code);
+        const EventContext& context = event.context;
+
+        // Input goes back through InputSystem so its key and mouse state
+        // matches the recorded run, InputSystem posts the event itself.
+        switch (code) {
+            case SystemEventCode::KeyPressed:
+            case SystemEventCode::KeyReleased:
+                InputSystem::process_key(context.data.u16[0], code == SystemEventCode::KeyPressed);
+                break;
+            case SystemEventCode::ButtonPressed:
+            case SystemEventCode::ButtonReleased:
+                InputSystem::process_mouse_button(static_cast<MouseButton>(context.data.u8[0]), code == SystemEventCode::ButtonPressed);
+                break;
+            case SystemEventCode::MouseMoved:
+                InputSystem::process_mouse_move(context.data.i16[0], context.data.i16[1]);
+                break;
+            case SystemEventCode::MouseWheel:
+                InputSystem::process_mouse_wheel(context.data.i8[0]);
+                break;
+            default:
+                EventSystem::post_event(code, nullptr, context);
+                break;
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "systems/event_system.h"
+
+namespace nk {
+    // Records the events that come from outside the engine, everything posted
+    // on the main thread while the platform pumps its messages, and plays them
+    // back at the same frame boundaries. Replays run with a fixed delta time,
+    // so two runs of the same recording take the same path through the frame
+    // and can be compared against each other.
+    class EventRecorder {
+    public:
+        enum class Mode : u8 {
+            Idle,
+            Recording,
+            Replaying,
+        };
+
+        // 32 bytes per event on disk, after a FileHeader.
+        struct RecordedEvent {
+            u64 timestamp_ns;
+            u32 frame;
+            u16 code;
+            u16 reserved;
+            EventContext context;
+        };
+
+        struct FileHeader {
+            u32 magic;
+            u16 version;
+            u16 record_size;
+            u32 frame_count;
+            u32 event_count;
+        };
+
+        static constexpr u32 file_magic = 0x52454B4E; // "NKER"
+        static constexpr u16 file_version = 1;
+        static constexpr f64 default_fixed_delta = 1.0 / 60.0;
+
+        ~EventRecorder() = default;
+
+        static EventRecorder& init();
+        static void shutdown();
+
+        static EventRecorder& get() {
+            static EventRecorder instance;
+            return instance;
+        }
+
+        // The file is written when recording stops, shutdown stops it too.
+        static bool start_recording(cstr path);
+        static bool stop_recording();
+
+        static bool start_replay(cstr path, f64 fixed_delta = default_fixed_delta);
+        static void stop_replay();
+
+        // Engine::run_impl wraps pump_messages with these. end_capture closes
+        // the frame; while replaying it is where the recorded events of the
+        // frame are posted again, and after the last frame ApplicationQuit.
+        static void begin_capture() { get().m_capturing = true; }
+        static void end_capture() { get().end_capture_impl(); }
+
+        // Called by EventSystem::post_event, returns false when the event has
+        // to be dropped because a replay owns the input.
+        static bool capture(SystemEventCode code, const EventContext& context) { return get().capture_impl(code, context); }
+        // Live input is ignored while replaying, InputSystem checks this.
+        static bool drops_live_input() {
+            const EventRecorder& instance = get();
+            return instance.m_mode == Mode::Replaying && !instance.m_injecting;
+        }
+
+        static Mode mode() { return get().m_mode; }
+        static bool replaying() { return get().m_mode == Mode::Replaying; }
+        static f64 fixed_delta() { return get().m_fixed_delta; }
+        static u32 frame() { return get().m_frame; }
+
+    private:
+        EventRecorder() = default;
+
+        void end_capture_impl();
+        bool capture_impl(SystemEventCode code, const EventContext& context);
+        void inject(const RecordedEvent& event);
+
+        mem::Allocator* m_allocator;
+        cl::dyarr<RecordedEvent> m_events;
+        str m_path;
+        std::chrono::steady_clock::time_point m_start;
+        f64 m_fixed_delta;
+        u64 m_cursor;
+        u32 m_frame;
+        u32 m_frame_count;
+        Mode m_mode;
+        bool m_capturing;
+        bool m_injecting;
+    };
+}
@@ -1,6 +1,8 @@
 #include "nkpch.h"
 
 #include "systems/event_system.h"
+#include "systems/event_channel.h"
+#include "systems/event_recorder.h"
 #include "memory/malloc_allocator.h"
 
 namespace nk {
@@ -10,6 +12,40 @@ namespace nk {
         instance.m_allocator = native_construct(mem::MallocAllocator);
         instance.m_allocator->allocator_init(mem::MallocAllocator, "EventSystem", MemoryType::Event);
 
+        instance.m_subscriptions.dyarr_init(instance.m_allocator, 32);
+        instance.m_free_subscription = none;
+        instance.m_next_order = 0;
+
+        instance.m_channels.dyarr_init(instance.m_allocator, 8);
+        for (PayloadArena& arena : instance.m_arenas) {
+            arena.blocks.dyarr_init(instance.m_allocator, 4);
+            arena.block = 0;
+            arena.offset = 0;
+        }
+        instance.m_arena_index = 0;
+
+        instance.m_queue_length = 0;
+        instance.m_dispatching = false;
+        instance.m_main_thread = std::this_thread::get_id();
+
+        const u16 max_event_codes = static_cast<u16>(SystemEventCode::MaxEventCode);
+        for (u16 i = 0; i < max_event_codes; i++) {
+            instance.m_registered[i].coalesce = nullptr;
+            instance.m_registered[i].queued_index = none;
+        }
+
+#if NK_EVENT_STATS
+        instance.m_stats_enabled = false;
+        instance.m_stats_interval = 0.0;
+        reset_stats();
+#endif
+
+        // One resize and one mouse move per frame at most, a drag resize
+        // would otherwise rebuild the swapchain once per OS message.
+        set_coalescing(SystemEventCode::MouseMoved, coalesce_keep_last);
+        set_coalescing(SystemEventCode::Resized, coalesce_keep_last);
+        set_coalescing(SystemEventCode::MouseWheel, coalesce_accumulate_i8);
+
         TraceLog("nk::EventSystem Initialized.");
         return instance;
     }
@@ -17,55 +53,227 @@ namespace nk {
     void EventSystem::shutdown() {
         EventSystem& instance = get();
 
+        QueuedEvent discarded;
+        while (instance.m_inbox.mpsc_queue_pop(discarded)) {
+            instance.m_queue_length++;
+        }
+
+        if (instance.m_queue_length > 0) {
+            WarnLog("nk::EventSystem Shutting down with {} undispatched events.", instance.m_queue_length);
+            instance.m_queue_length = 0;
+        }
+
         const u16 max_event_codes = static_cast<u16>(SystemEventCode::MaxEventCode);
         for (u16 i = 0; i < max_event_codes; i++) {
             if (instance.m_registered[i].events.capacity() > 0) {
                 instance.m_registered[i].events.dyarr_shutdown();
             }
+            if (instance.m_registered[i].queues.capacity() > 0) {
+                instance.m_registered[i].queues.dyarr_shutdown();
+            }
+            instance.m_registered[i].unsorted = false;
+        }
+        instance.m_subscriptions.dyarr_shutdown();
+
+        for (EventChannelBase* channel : instance.m_channels) {
+            channel->shutdown();
+        }
+        instance.m_channels.dyarr_shutdown();
+
+        for (PayloadArena& arena : instance.m_arenas) {
+            for (PayloadArena::Block& block : arena.blocks) {
+                instance.m_allocator->free_lot_t(u8, block.data, block.size_bytes);
+            }
+            arena.blocks.dyarr_shutdown();
         }
 
         native_deconstruct(mem::MallocAllocator, instance.m_allocator);
         TraceLog("nk::EventSystem Shutdown.");
     }
 
-    bool EventSystem::register_event(SystemEventCode code, void* listener, PFN_OnEvent callback) {
+    EventHandle EventSystem::register_event(SystemEventCode code, void* listener, PFN_OnEvent callback, i32 priority) {
         EventSystem& instance = get();
 
-        const u16 code_value = static_cast<u16>(code);
+        EventCodeEntry& entry = instance.m_registered[static_cast<u16>(code)];
+        if (entry.events.capacity() <= 0) {
+            entry.events.dyarr_init(instance.m_allocator, 4);
+        }
 
-        if (instance.m_registered[code_value].events.capacity() <= 0) {
-            instance.m_registered[code_value].events.dyarr_init(instance.m_allocator, 4);
+        u32 index = instance.m_free_subscription;
+        if (index != none) {
+            instance.m_free_subscription = instance.m_subscriptions[index].position;
+        } else {
+            index = static_cast<u32>(instance.m_subscriptions.length());
+            instance.m_subscriptions.dyarr_push_copy(Subscription{.generation = 0});
         }
 
-        const u64 registered_count = instance.m_registered[code_value].events.length();
-        for (u64 i = 0; i < registered_count; i++) {
-            if (instance.m_registered[code_value].events[i].listener == listener) {
-                return false;
-            }
+        // Appending keeps the order unless it outranks the current last one.
+        if (!entry.events.empty() && entry.events.dyarr_last().priority < priority) {
+            entry.unsorted = true;
         }
 
-        instance.m_registered[code_value].events.dyarr_push_copy(RegisteredEvent{
+        Subscription& subscription = instance.m_subscriptions[index];
+        subscription.position = static_cast<u32>(entry.events.length());
+        subscription.code = code;
+        subscription.active = true;
+#if NK_EVENT_STATS
+        subscription.stats = EventListenerStats{};
+#endif
+
+        entry.events.dyarr_push_copy(RegisteredEvent{
             .listener = listener,
             .callback = callback,
+            .priority = priority,
+            .order = instance.m_next_order++,
+            .subscription = index,
         });
 
+        return EventHandle{
+            .index = index,
+            .generation = subscription.generation,
+        };
+    }
+
+    bool EventSystem::unregister_event(EventHandle handle) {
+        if (!is_registered(handle))
+            return false;
+
+        EventSystem& instance = get();
+        Subscription& subscription = instance.m_subscriptions[handle.index];
+        EventCodeEntry& entry = instance.m_registered[static_cast<u16>(subscription.code)];
+
+        const u32 position = subscription.position;
+        entry.events.dyarr_swap_remove(position);
+        if (position < entry.events.length()) {
+            instance.m_subscriptions[entry.events[position].subscription].position = position;
+            entry.unsorted = true;
+        }
+
+        subscription.active = false;
+        subscription.generation++;
+        subscription.position = instance.m_free_subscription;
+        instance.m_free_subscription = handle.index;
         return true;
     }
 
-    bool EventSystem::unregister_event(SystemEventCode code, void* listener, PFN_OnEvent callback) {
+    bool EventSystem::is_registered(EventHandle handle) {
+        EventSystem& instance = get();
+
+        if (handle.index >= instance.m_subscriptions.length())
+            return false;
+
+        const Subscription& subscription = instance.m_subscriptions[handle.index];
+        return subscription.active && subscription.generation == handle.generation;
+    }
+
+    bool EventSystem::fire_event(SystemEventCode code, void* sender, const EventContext& ctx) {
         EventSystem& instance = get();
 
         const u16 code_value = static_cast<u16>(code);
 
-        if (instance.m_registered[code_value].events.empty()) {
+        if (!instance.m_registered[code_value].queues.empty()) {
+            const QueuedEvent event = {
+                .context = ctx,
+                .sender = sender,
+                .code = code,
+            };
+            instance.deliver_to_queues(instance.m_registered[code_value], event);
+        }
+
+        return instance.deliver(instance.m_registered[code_value], code, sender, ctx);
+    }
+
+    bool EventSystem::post_event(SystemEventCode code, void* sender, const EventContext& ctx) {
+        EventSystem& instance = get();
+
+        const QueuedEvent event = {
+            .context = ctx,
+            .sender = sender,
+            .code = code,
+        };
+
+        if (std::this_thread::get_id() != instance.m_main_thread)
+            return instance.m_inbox.mpsc_queue_push(event);
+
+        if (!EventRecorder::capture(code, ctx))
             return false;
+
+        if (instance.queue_event(event))
+            return true;
+
+        if (instance.m_dispatching) {
+            WarnLog("nk::EventSystem::post_event Queue full while dispatching, firing event {} immediately.", static_cast<u16>(code));
+            fire_event(code, sender, ctx);
+            return true;
+        }
+
+        WarnLog("nk::EventSystem::post_event Queue full, dispatching early.");
+        instance.dispatch_impl();
+        instance.queue_event(event);
+        return true;
+    }
+
+    void EventSystem::set_coalescing(SystemEventCode code, PFN_OnCoalesce coalesce) {
+        EventCodeEntry& entry = get().m_registered[static_cast<u16>(code)];
+        entry.coalesce = coalesce;
+        entry.queued_index = none;
+    }
+
+    void EventSystem::coalesce_keep_last(EventContext& queued, const EventContext& incoming) {
+        queued = incoming;
+    }
+
+    void EventSystem::coalesce_accumulate_i8(EventContext& queued, const EventContext& incoming) {
+        const i32 sum = static_cast<i32>(queued.data.i8[0]) + static_cast<i32>(incoming.data.i8[0]);
+        queued.data.i8[0] = static_cast<i8>(MaxValue(MinValue(sum, i32{numeric::i8_max}), -i32{numeric::i8_max} - 1));
+    }
+
+    bool EventSystem::queue_event(const QueuedEvent& event) {
+        EventCodeEntry& entry = m_registered[static_cast<u16>(event.code)];
+        if (entry.coalesce != nullptr && entry.queued_index != none) {
+            QueuedEvent& queued = m_queue[entry.queued_index];
+            entry.coalesce(queued.context, event.context);
+            queued.sender = event.sender;
+            return true;
         }
 
-        const u64 registered_count = instance.m_registered[code_value].events.length();
-        for (u64 i = 0; i < registered_count; i++) {
-            RegisteredEvent& event = instance.m_registered[code_value].events[i];
-            if (event.listener == listener && event.callback == callback) {
-                instance.m_registered[code_value].events.dyarr_remove(i);
+        if (m_queue_length == queue_capacity)
+            return false;
+
+        if (entry.coalesce != nullptr)
+            entry.queued_index = static_cast<u32>(m_queue_length);
+
+        m_queue[m_queue_length++] = event;
+        return true;
+    }
+
+    bool EventSystem::register_queue(SystemEventCode code, ThreadEventQueue* queue) {
+        EventSystem& instance = get();
+        Assert(is_main_thread(), "nk::EventSystem::register_queue Must be called from the main thread!");
+
+        cl::dyarr<ThreadEventQueue*>& queues = instance.m_registered[static_cast<u16>(code)].queues;
+        if (queues.capacity() <= 0) {
+            queues.dyarr_init(instance.m_allocator, 2);
+        }
+
+        for (ThreadEventQueue* registered : queues) {
+            if (registered == queue) {
+                return false;
+            }
+        }
+
+        queues.dyarr_push_copy(queue);
+        return true;
+    }
+
+    bool EventSystem::unregister_queue(SystemEventCode code, ThreadEventQueue* queue) {
+        EventSystem& instance = get();
+        Assert(is_main_thread(), "nk::EventSystem::unregister_queue Must be called from the main thread!");
+
+        cl::dyarr<ThreadEventQueue*>& queues = instance.m_registered[static_cast<u16>(code)].queues;
+        for (u64 i = 0; i < queues.length(); i++) {
+            if (queues[i] == queue) {
+                queues.dyarr_remove(i);
                 return true;
             }
         }
@@ -73,23 +281,277 @@ namespace nk {
         return false;
     }
 
-    bool EventSystem::fire_event(SystemEventCode code, void* sender, const EventContext& ctx) {
-        EventSystem& instance = get();
+    void EventSystem::dispatch_impl() {
+        if (m_dispatching)
+            return;
 
-        const u16 code_value = static_cast<u16>(code);
+        // Worker posts join the frame queue behind the ones from this thread,
+        // whatever does not fit stays in the inbox for the next dispatch.
+        QueuedEvent inbox_event;
+        while (m_queue_length < queue_capacity && m_inbox.mpsc_queue_pop(inbox_event)) {
+            queue_event(inbox_event);
+        }
 
-        if (instance.m_registered[code_value].events.empty()) {
-            return false;
+        if (m_queue_length == 0)
+            return;
+
+        // Counting sort by code into the dispatch queue, stable so each code
+        // keeps its posting order.
+        constexpr u16 max_event_codes = static_cast<u16>(SystemEventCode::MaxEventCode);
+        u32 offsets[max_event_codes] = {};
+        for (u64 i = 0; i < m_queue_length; i++) {
+            const u16 code = static_cast<u16>(m_queue[i].code);
+            offsets[code]++;
+            m_registered[code].queued_index = none;
         }
 
-        const u64 registered_count = instance.m_registered[code_value].events.length();
-        for (u64 i = 0; i < registered_count; i++) {
-            RegisteredEvent& event = instance.m_registered[code_value].events[i];
-            if (event.callback(code, sender, event.listener, ctx)) {
+        u32 total = 0;
+        for (u16 code = 0; code < max_event_codes; code++) {
+            const u32 count = offsets[code];
+            offsets[code] = total;
+            total += count;
+        }
+
+        for (u64 i = 0; i < m_queue_length; i++) {
+            m_dispatch_queue[offsets[static_cast<u16>(m_queue[i].code)]++] = m_queue[i];
+        }
+
+        // The queue is free again before any listener runs, so listeners can post.
+        const u64 count = m_queue_length;
+        m_queue_length = 0;
+        m_dispatching = true;
+
+        u64 i = 0;
+        while (i < count) {
+            const SystemEventCode code = m_dispatch_queue[i].code;
+            u64 end = i + 1;
+            while (end < count && m_dispatch_queue[end].code == code) {
+                end++;
+            }
+
+            EventCodeEntry& entry = m_registered[static_cast<u16>(code)];
+            for (; i < end; i++) {
+                const QueuedEvent& event = m_dispatch_queue[i];
+                if (!entry.queues.empty())
+                    deliver_to_queues(entry, event);
+
+                deliver(entry, code, event.sender, event.context);
+            }
+        }
+
+        m_dispatching = false;
+    }
+
+    bool EventSystem::deliver(EventCodeEntry& entry, SystemEventCode code, void* sender, const EventContext& ctx) {
+#if NK_EVENT_STATS
+        if (m_stats_enabled)
+            return deliver_measured(entry, code, sender, ctx);
+#endif
+
+        if (entry.unsorted)
+            sort_listeners(entry);
+
+        cl::dyarr<RegisteredEvent>& events = entry.events;
+        for (u64 i = 0; i < events.length(); i++) {
+            if (events[i].callback(code, sender, events[i].listener, ctx))
+                return true;
+        }
+
+        return false;
+    }
+
+#if NK_EVENT_STATS
+    bool EventSystem::deliver_measured(EventCodeEntry& entry, SystemEventCode code, void* sender, const EventContext& ctx) {
+        EventCodeStats& stats = entry.stats;
+        stats.event_count++;
+
+        if (entry.unsorted)
+            sort_listeners(entry);
+
+        cl::dyarr<RegisteredEvent>& events = entry.events;
+        for (u64 i = 0; i < events.length(); i++) {
+            const u32 index = events[i].subscription;
+            const u64 start = os::read_cycle_counter();
+            const bool consumed = events[i].callback(code, sender, events[i].listener, ctx);
+            const u64 cycles = os::read_cycle_counter() - start;
+
+            // Looked up after the call, the callback may register listeners and move the slots.
+            Subscription& subscription = m_subscriptions[index];
+            EventListenerStats& listener = subscription.stats;
+            listener.callback_count++;
+            listener.cycles += cycles;
+            listener.max_cycles = MaxValue(listener.max_cycles, cycles);
+            stats.callback_count++;
+            stats.cycles += cycles;
+            stats.max_cycles = MaxValue(stats.max_cycles, cycles);
+
+            if (consumed) {
+                listener.consumed_count++;
+                stats.consumed_count++;
+                stats.last_consumer = EventHandle{
+                    .index = index,
+                    .generation = subscription.generation,
+                };
                 return true;
             }
         }
 
         return false;
     }
+
+    void EventSystem::set_stats_enabled(bool enabled, f64 summary_interval) {
+        EventSystem& instance = get();
+        instance.m_stats_enabled = enabled;
+        instance.m_stats_interval = summary_interval;
+        instance.m_stats_elapsed = 0.0;
+    }
+
+    EventCodeStats EventSystem::code_stats(SystemEventCode code) {
+        const EventCodeEntry& entry = get().m_registered[static_cast<u16>(code)];
+        EventCodeStats stats = entry.stats;
+        stats.listener_count = static_cast<u32>(entry.events.length());
+        return stats;
+    }
+
+    EventListenerStats EventSystem::listener_stats(EventHandle handle) {
+        if (!is_registered(handle))
+            return EventListenerStats{};
+        return get().m_subscriptions[handle.index].stats;
+    }
+
+    void EventSystem::reset_stats() {
+        EventSystem& instance = get();
+
+        for (EventCodeEntry& entry : instance.m_registered) {
+            entry.stats = EventCodeStats{.last_consumer = invalid_handle};
+        }
+        for (Subscription& subscription : instance.m_subscriptions) {
+            subscription.stats = EventListenerStats{};
+        }
+        instance.m_stats_elapsed = 0.0;
+    }
+
+    void EventSystem::log_stats_summary() {
+        InfoLog("nk::EventSystem Dispatch stats (code: events, listeners, callbacks, consumed, avg/max cycles):");
+        const u16 max_event_codes = static_cast<u16>(SystemEventCode::MaxEventCode);
+        for (u16 i = 0; i < max_event_codes; i++) {
+            const EventCodeStats stats = code_stats(static_cast<SystemEventCode>(i));
+            if (stats.event_count == 0)
+                continue;
+
+            const u64 average = stats.callback_count > 0 ? stats.cycles / stats.callback_count : 0;
+            InfoLog("    {:#04x}: {}, {}, {}, {}, {}/{}",
+                    i, stats.event_count, stats.listener_count, stats.callback_count, stats.consumed_count, average, stats.max_cycles);
+        }
+    }
+
+    void EventSystem::update_stats(f64 delta_time) {
+        EventSystem& instance = get();
+        if (!instance.m_stats_enabled || instance.m_stats_interval <= 0.0)
+            return;
+
+        instance.m_stats_elapsed += delta_time;
+        if (instance.m_stats_elapsed >= instance.m_stats_interval) {
+            instance.m_stats_elapsed = 0.0;
+            log_stats_summary();
+        }
+    }
+#endif
+
+    void EventSystem::dispatch_channels() {
+        if (m_channels.empty() || m_dispatching)
+            return;
+
+        const u8 buffer = m_arena_index;
+        m_arena_index ^= 1;
+        m_dispatching = true;
+
+        for (EventChannelBase* channel : m_channels) {
+            channel->dispatch(buffer);
+        }
+
+        m_arenas[buffer].block = 0;
+        m_arenas[buffer].offset = 0;
+        m_dispatching = false;
+    }
+
+    void* EventSystem::allocate_payload(u64 size_bytes, u64 alignment) {
+        PayloadArena& arena = m_arenas[m_arena_index];
+
+        while (arena.block < arena.blocks.length()) {
+            PayloadArena::Block& block = arena.blocks[arena.block];
+            const u64 start = (reinterpret_cast<u64>(block.data) + arena.offset + alignment - 1) & ~(alignment - 1);
+            const u64 offset = start - reinterpret_cast<u64>(block.data);
+            if (offset + size_bytes <= block.size_bytes) {
+                arena.offset = offset + size_bytes;
+                return block.data + offset;
+            }
+
+            arena.block++;
+            arena.offset = 0;
+        }
+
+        // Out of blocks for this frame, payloads larger than a block get one of their own.
+        const u64 block_size = size_bytes + alignment > arena_block_size ? size_bytes + alignment : arena_block_size;
+        arena.blocks.dyarr_push_copy(PayloadArena::Block{
+            .data = m_allocator->allocate_lot_t(u8, block_size),
+            .size_bytes = block_size,
+        });
+
+        PayloadArena::Block& block = arena.blocks.dyarr_last();
+        const u64 start = (reinterpret_cast<u64>(block.data) + alignment - 1) & ~(alignment - 1);
+        arena.offset = start - reinterpret_cast<u64>(block.data) + size_bytes;
+        return reinterpret_cast<void*>(start);
+    }
+
+    mem::Allocator* EventChannelBase::allocator() {
+        return EventSystem::get().m_allocator;
+    }
+
+    void EventChannelBase::add_channel(EventChannelBase* channel) {
+        EventSystem& instance = EventSystem::get();
+
+        for (EventChannelBase* registered : instance.m_channels) {
+            Assert(registered->channel_id() != channel->channel_id(), "nk::EventChannel Two payload types share the same channel_id!");
+        }
+
+        instance.m_channels.dyarr_push_ptr(channel);
+    }
+
+    void* EventChannelBase::allocate_payload(u64 size_bytes, u64 alignment) {
+        return EventSystem::get().allocate_payload(size_bytes, alignment);
+    }
+
+    u8 EventChannelBase::posting_buffer() {
+        return EventSystem::get().m_arena_index;
+    }
+
+    void EventSystem::sort_listeners(EventCodeEntry& entry) {
+        // Insertion sort, only the listeners swapped in by removals or the
+        // newly registered ones are out of place so this stays close to O(n).
+        cl::dyarr<RegisteredEvent>& events = entry.events;
+        for (u64 i = 1; i < events.length(); i++) {
+            const RegisteredEvent event = events[i];
+            u64 j = i;
+            while (j > 0 && (events[j - 1].priority < event.priority ||
+                             (events[j - 1].priority == event.priority && events[j - 1].order > event.order))) {
+                events[j] = events[j - 1];
+                j--;
+            }
+            events[j] = event;
+        }
+
+        for (u64 i = 0; i < events.length(); i++) {
+            m_subscriptions[events[i].subscription].position = static_cast<u32>(i);
+        }
+        entry.unsorted = false;
+    }
+
+    void EventSystem::deliver_to_queues(EventCodeEntry& entry, const QueuedEvent& event) {
+        for (ThreadEventQueue* queue : entry.queues) {
+            if (!queue->mpsc_queue_push(event)) {
+                WarnLog("nk::EventSystem Thread queue full, dropping event {}.", static_cast<u16>(event.code));
+            }
+        }
+    }
 }
@@ -1,6 +1,13 @@
 #pragma once
 
 #include "collections/dyarr.h"
+#include "collections/mpsc_queue.h"
+
+// Per code dispatch statistics, compiled in by default for debug builds.
+// When compiled in they still cost nothing but a branch until enabled.
+#ifndef NK_EVENT_STATS
+    #define NK_EVENT_STATS NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO
+#endif
 
 namespace nk {
     struct EventContext {
@@ -41,17 +48,83 @@ namespace nk {
                  void* listener,
                  EventContext context);
 
+    // Merges an event posted while another one of the same code is still
+    // queued into the queued one, so each dispatch sees at most one of them.
+    using PFN_OnCoalesce = void (*)(EventContext& queued, const EventContext& incoming);
+
+    struct EventHandle {
+        u32 index;
+        u32 generation;
+    };
+
     struct RegisteredEvent {
         void* listener;
         PFN_OnEvent callback;
+        i32 priority;
+        u32 order;
+        u32 subscription;
+    };
+
+    struct QueuedEvent {
+        EventContext context;
+        void* sender;
+        SystemEventCode code;
+    };
+
+    // Owned by a worker thread. The main thread pushes every event of the
+    // codes the queue is registered for, the worker pops them on its side.
+    using ThreadEventQueue = cl::mpsc_queue<QueuedEvent, 256>;
+
+    class EventChannelBase;
+
+#if NK_EVENT_STATS
+    // Cycles come from os::read_cycle_counter.
+    struct EventListenerStats {
+        u64 callback_count;
+        u64 consumed_count;
+        u64 cycles;
+        u64 max_cycles;
     };
 
+    struct EventCodeStats {
+        // Fired or dispatched, once per event no matter the listeners.
+        u64 event_count;
+        u64 callback_count;
+        u64 consumed_count;
+        u64 cycles;
+        u64 max_cycles;
+        u32 listener_count;
+        // Listener that consumed the last consumed event of the code.
+        EventHandle last_consumer;
+    };
+#endif
+
     struct EventCodeEntry {
         cl::dyarr<RegisteredEvent> events;
+        cl::dyarr<ThreadEventQueue*> queues;
+        // Null keeps every posted event.
+        PFN_OnCoalesce coalesce;
+        // Slot in the post queue of the event new posts merge into.
+        u32 queued_index;
+        // Set when a removal or a higher priority registration broke the
+        // order, listeners are sorted again before the next delivery.
+        bool unsorted;
+#if NK_EVENT_STATS
+        EventCodeStats stats;
+#endif
     };
 
     class EventSystem {
     public:
+        static constexpr u64 queue_capacity = 1024;
+        static constexpr u64 inbox_capacity = 1024;
+        static constexpr u64 arena_block_size = KiB(64);
+
+        static constexpr EventHandle invalid_handle = {
+            .index = std::numeric_limits<u32>::max(),
+            .generation = 0,
+        };
+
         ~EventSystem() = default;
 
         static EventSystem& init();
@@ -62,14 +135,149 @@ namespace nk {
             return instance;
         }
 
-        static bool register_event(SystemEventCode code, void* listener, PFN_OnEvent callback);
-        static bool unregister_event(SystemEventCode code, void* listener, PFN_OnEvent callback);
+        // Listeners run from the highest priority down, equal priorities in
+        // registration order, so handlers that usually consume the event
+        // should get a high priority to stop the delivery early. The same
+        // listener can register any number of callbacks, each one gets its
+        // own handle.
+        static EventHandle register_event(SystemEventCode code, void* listener, PFN_OnEvent callback, i32 priority = 0);
+        // O(1), the last listener of the code is swapped in and the order is
+        // fixed on the next delivery. A listener unregistered while its code
+        // is being delivered can make the swapped one miss that event.
+        static bool unregister_event(EventHandle handle);
+        static bool is_registered(EventHandle handle);
         static bool fire_event(SystemEventCode code, void* sender, const EventContext& ctx);
 
+        // Queues the event for the next dispatch() instead of calling the
+        // listeners right away. The queue is a fixed array, posting never
+        // allocates; a full queue is dispatched early so no event is lost.
+        // Any thread can post, events from other threads go through a
+        // lock-free inbox that dispatch() drains. Those posts never block and
+        // return false when the inbox is full. Also false for live input
+        // dropped while EventRecorder replays a recording.
+        static bool post_event(SystemEventCode code, void* sender, const EventContext& ctx);
+
+        // Coalescing applies to posted events only, fire_event always runs
+        // the listeners. init sets keep last for MouseMoved and Resized and
+        // accumulate for MouseWheel, every other code keeps all its events.
+        static void set_coalescing(SystemEventCode code, PFN_OnCoalesce coalesce);
+        static void coalesce_keep_last(EventContext& queued, const EventContext& incoming);
+        // Saturating sum of the i8 in data.i8[0], the MouseWheel layout.
+        static void coalesce_accumulate_i8(EventContext& queued, const EventContext& incoming);
+
+        // Main thread only. Events of code are copied into the queue when
+        // they are fired or dispatched, listeners consuming them does not
+        // stop the delivery.
+        static bool register_queue(SystemEventCode code, ThreadEventQueue* queue);
+        static bool unregister_queue(SystemEventCode code, ThreadEventQueue* queue);
+
+        // Delivers every event posted before the call, grouped by code so all
+        // listeners of one code run back to back. Events keep their posting
+        // order within a code, events posted by listeners wait for the next
+        // dispatch. EventChannel payloads are delivered after, channel by
+        // channel, and their arena is reset once all of them ran.
+        static void dispatch() {
+            get().dispatch_impl();
+            get().dispatch_channels();
+        }
+
+        static u64 queued_count() { return get().m_queue_length; }
+
+        static bool is_main_thread() { return std::this_thread::get_id() == get().m_main_thread; }
+
+#if NK_EVENT_STATS
+        // A summary_interval above zero logs log_stats_summary that often,
+        // driven by update_stats.
+        static void set_stats_enabled(bool enabled, f64 summary_interval = 0.0);
+        static bool stats_enabled() { return get().m_stats_enabled; }
+        static EventCodeStats code_stats(SystemEventCode code);
+        static EventListenerStats listener_stats(EventHandle handle);
+        static void reset_stats();
+        static void log_stats_summary();
+        static void update_stats(f64 delta_time);
+#endif
+
     private:
+        struct Subscription {
+            // Index in the events of code while active, next free slot after.
+            u32 position;
+            u32 generation;
+            SystemEventCode code;
+            bool active;
+#if NK_EVENT_STATS
+            EventListenerStats stats;
+#endif
+        };
+
+        // Bump allocator made of blocks that are kept across frames, so once
+        // the busiest frame has been seen posting payloads stops allocating.
+        struct PayloadArena {
+            struct Block {
+                u8* data;
+                u64 size_bytes;
+            };
+
+            cl::dyarr<Block> blocks;
+            u64 block;
+            u64 offset;
+        };
+
+        static constexpr u32 none = std::numeric_limits<u32>::max();
+
         EventSystem() = default;
 
+        // Coalesces into the queued event of the same code when possible, false only when a new slot is needed and the queue is full.
+        bool queue_event(const QueuedEvent& event);
+        void dispatch_impl();
+        void dispatch_channels();
+        void* allocate_payload(u64 size_bytes, u64 alignment);
+        void sort_listeners(EventCodeEntry& entry);
+        void deliver_to_queues(EventCodeEntry& entry, const QueuedEvent& event);
+
+        // Runs the listeners of code in order until one consumes the event.
+        bool deliver(EventCodeEntry& entry, SystemEventCode code, void* sender, const EventContext& ctx);
+#if NK_EVENT_STATS
+        bool deliver_measured(EventCodeEntry& entry, SystemEventCode code, void* sender, const EventContext& ctx);
+#endif
+
         mem::Allocator* m_allocator;
         EventCodeEntry m_registered[static_cast<u16>(SystemEventCode::MaxEventCode)];
+
+        cl::dyarr<Subscription> m_subscriptions;
+        u32 m_free_subscription;
+        u32 m_next_order;
+
+        QueuedEvent m_queue[queue_capacity];
+        QueuedEvent m_dispatch_queue[queue_capacity];
+        u64 m_queue_length;
+        bool m_dispatching;
+
+        cl::mpsc_queue<QueuedEvent, inbox_capacity> m_inbox;
+        std::thread::id m_main_thread;
+
+        // Posts fill m_arenas[m_arena_index], dispatch flips the index before
+        // delivering so payloads posted by channel listeners survive the reset.
+        cl::dyarr<EventChannelBase*> m_channels;
+        PayloadArena m_arenas[2];
+        u8 m_arena_index;
+
+#if NK_EVENT_STATS
+        f64 m_stats_interval;
+        f64 m_stats_elapsed;
+        bool m_stats_enabled;
+#endif
+
+        friend class EventChannelBase;
     };
 }
+
+#if NK_EVENT_STATS
+
+    #define NK_EVENT_STATS_UPDATE(delta_time) \
+        nk::EventSystem::update_stats(delta_time)
+
+#else
+
+    #define NK_EVENT_STATS_UPDATE(delta_time)
+
+#endif
@@ -0,0 +1,215 @@
+#include "nkpch.h"
+
+#include "systems/file_log_sink.h"
+#include "systems/log_compression.h"
+
+namespace nk {
+    static i64 now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    FileLogSink::FileLogSink(const LoggingSystemConfig& config)
+        : m_path{config.file_path},
+          m_max_size{config.file_max_size},
+          m_max_age_ns{static_cast<i64>(config.file_max_age_seconds) * 1'000'000'000},
+          m_max_backups{config.file_max_backups},
+          m_compress{config.file_compress},
+          m_flush_interval_ns{static_cast<i64>(config.file_flush_interval_ms) * 1'000'000},
+          m_open{false},
+          m_size{0},
+          m_opened_ns{0},
+          m_last_flush_ns{0},
+          m_pending_count{0},
+          m_compress_running{false} {
+        const std::filesystem::path path(m_path);
+        m_directory = path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+        m_stem = path.stem().string();
+        m_extension = path.extension().string();
+        m_buffer.reserve(buffer_size);
+    }
+
+    FileLogSink::~FileLogSink() {
+        if (m_open) {
+            write_buffer();
+            m_file.close();
+        }
+
+        // Files still queued are compressed before the thread stops.
+        if (m_compressor.joinable()) {
+            {
+                std::lock_guard lock(m_compress_mutex);
+                m_compress_running = false;
+            }
+            m_compress_signal.notify_one();
+            m_compressor.join();
+        }
+    }
+
+    bool FileLogSink::open() {
+        if (m_compress) {
+            m_compress_running = true;
+            m_compressor = std::thread(&FileLogSink::compression_loop, this);
+        }
+
+        const i64 now = now_ns();
+        std::error_code error;
+        if (std::filesystem::file_size(m_path, error) > 0 && !error) {
+            rotate(now);
+        } else {
+            m_open = m_file.open(m_path.c_str(), FileMode::Write, true);
+            m_opened_ns = now;
+        }
+
+        m_last_flush_ns = now;
+        return m_open;
+    }
+
+    void FileLogSink::write(std::string_view lines) {
+        if (!m_open)
+            return;
+
+        const i64 now = now_ns();
+        const bool too_big = m_max_size > 0 && m_size > 0 && m_size + lines.size() > m_max_size;
+        const bool too_old = m_max_age_ns > 0 && now - m_opened_ns >= m_max_age_ns;
+        if (too_big || too_old) {
+            rotate(now);
+            if (!m_open)
+                return;
+        }
+
+        m_buffer.append(lines);
+        m_size += lines.size();
+        if (m_buffer.size() >= buffer_size) {
+            write_buffer();
+        }
+    }
+
+    void FileLogSink::idle() {
+        if (!m_buffer.empty() && now_ns() - m_last_flush_ns >= m_flush_interval_ns) {
+            flush();
+        }
+    }
+
+    void FileLogSink::flush() {
+        write_buffer();
+        m_last_flush_ns = now_ns();
+    }
+
+    void FileLogSink::write_buffer() {
+        if (!m_open || m_buffer.empty())
+            return;
+
+        u64 written;
+        m_file.write(m_buffer.size(), m_buffer.data(), &written);
+        m_buffer.clear();
+    }
+
+    void FileLogSink::rotate(i64 now) {
+        write_buffer();
+        m_file.close();
+
+        const std::time_t time = static_cast<std::time_t>(now / 1'000'000'000);
+        const std::tm* tm = std::localtime(&time);
+        const std::string timestamp = std::format("{:04}{:02}{:02}-{:02}{:02}{:02}", tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday,
+                                                  tm->tm_hour, tm->tm_min, tm->tm_sec);
+
+        // A second rotation within the same second gets a counter.
+        std::error_code error;
+        std::filesystem::path rotated;
+        for (u32 i = 0;; i++) {
+            const std::string name = i == 0 ? std::format("{}.{}{}", m_stem, timestamp, m_extension)
+                                            : std::format("{}.{}.{}{}", m_stem, timestamp, i, m_extension);
+            rotated = m_directory / name;
+            if (!std::filesystem::exists(rotated, error) && !std::filesystem::exists(rotated.string() + log_compression::file_extension, error))
+                break;
+        }
+
+        std::filesystem::rename(m_path, rotated, error);
+
+        m_open = m_file.open(m_path.c_str(), FileMode::Write, true);
+        m_size = 0;
+        m_opened_ns = now;
+
+        if (error)
+            return;
+
+        if (!m_compress) {
+            prune();
+            return;
+        }
+
+        {
+            std::lock_guard lock(m_compress_mutex);
+            if (m_pending_count < max_pending_compressions) {
+                m_pending[m_pending_count++] = rotated.string();
+                m_compress_signal.notify_one();
+                return;
+            }
+        }
+
+        // Rotating faster than the thread compresses, this one is done here.
+        if (log_compression::compress_file(rotated.string().c_str())) {
+            std::lock_guard lock(m_compress_mutex);
+            prune();
+        }
+    }
+
+    void FileLogSink::prune() {
+        if (m_max_backups == 0)
+            return;
+
+        const std::string prefix = m_stem + ".";
+        const std::string suffix = m_compress ? m_extension + log_compression::file_extension : m_extension;
+        const std::string current = std::filesystem::path(m_path).filename().string();
+
+        // Few files, the oldest is searched again after every removal.
+        while (true) {
+            std::error_code error;
+            u32 count = 0;
+            std::filesystem::path oldest;
+            std::filesystem::file_time_type oldest_time = std::filesystem::file_time_type::max();
+
+            for (const auto& entry : std::filesystem::directory_iterator(m_directory, error)) {
+                const std::string name = entry.path().filename().string();
+                if (name == current || !name.starts_with(prefix) || !name.ends_with(suffix))
+                    continue;
+
+                count++;
+                const auto time = entry.last_write_time(error);
+                if (time < oldest_time) {
+                    oldest_time = time;
+                    oldest = entry.path();
+                }
+            }
+
+            if (error || count <= m_max_backups)
+                return;
+
+            if (!std::filesystem::remove(oldest, error))
+                return;
+        }
+    }
+
+    void FileLogSink::compression_loop() {
+        while (true) {
+            std::string path;
+            {
+                std::unique_lock lock(m_compress_mutex);
+                m_compress_signal.wait(lock, [this]() { return m_pending_count > 0 || !m_compress_running; });
+                if (m_pending_count == 0)
+                    return;
+
+                path = std::move(m_pending[0]);
+                for (u32 i = 1; i < m_pending_count; i++) {
+                    m_pending[i - 1] = std::move(m_pending[i]);
+                }
+                m_pending_count--;
+            }
+
+            if (log_compression::compress_file(path.c_str())) {
+                std::lock_guard lock(m_compress_mutex);
+                prune();
+            }
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "platform/file.h"
+
+#include <condition_variable>
+
+namespace nk {
+    // The file output of LoggingSystemConfig. Lines collect in a buffer that
+    // is written when full, when a flush is due or after an Error line, so
+    // heavy logging costs a write per buffer instead of one per line.
+    class FileLogSink final : public LogSink {
+    public:
+        explicit FileLogSink(const LoggingSystemConfig& config);
+        ~FileLogSink() override;
+
+        // Rotates a log left by a previous run, false when the file could
+        // not be created.
+        bool open();
+
+        void write(std::string_view lines) override;
+        void idle() override;
+        void flush() override;
+
+        static constexpr u64 buffer_size = KiB(256);
+        static constexpr u32 max_pending_compressions = 8;
+
+    private:
+        void write_buffer();
+        void rotate(i64 now);
+        // Removes the oldest rotated files past max_backups, only the
+        // compressed ones when compression is on. Under m_compress_mutex
+        // then, files are compressed on two threads.
+        void prune();
+        void compression_loop();
+
+        std::string m_path;
+        std::filesystem::path m_directory;
+        std::string m_stem;
+        std::string m_extension;
+        u64 m_max_size;
+        i64 m_max_age_ns;
+        u32 m_max_backups;
+        bool m_compress;
+        i64 m_flush_interval_ns;
+
+        File m_file;
+        bool m_open;
+        std::string m_buffer;
+        // Bytes of the current file, the buffer included.
+        u64 m_size;
+        i64 m_opened_ns;
+        i64 m_last_flush_ns;
+
+        std::thread m_compressor;
+        std::mutex m_compress_mutex;
+        std::condition_variable m_compress_signal;
+        std::string m_pending[max_pending_compressions];
+        u32 m_pending_count;
+        bool m_compress_running;
+    };
+}
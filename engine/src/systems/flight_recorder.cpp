@@ -0,0 +1,229 @@
+#include "nkpch.h"
+
+#include "systems/flight_recorder.h"
+#include "systems/binary_log.h"
+#include "platform/file.h"
+
+#include <algorithm>
+
+namespace nk {
+    // Every open gets its own, sites compare against it.
+    static u32 recorder_generation = 0;
+
+    static u64 align_entry(u64 size_bytes) {
+        return (size_bytes + 7) & ~static_cast<u64>(7);
+    }
+
+    bool FlightRecorder::open(cstr path, u64 size_bytes) {
+        close();
+
+        // What a crash left behind stays until the next run.
+        std::error_code error;
+        const std::filesystem::path file(path);
+        if (std::filesystem::exists(file, error)) {
+            const std::filesystem::path previous = file.parent_path() / (file.stem().string() + ".previous" + file.extension().string());
+            std::filesystem::rename(file, previous, error);
+        }
+
+        // Entry sizes are u32, the ring stays well below.
+        size_bytes = MinValue(MaxValue(size_bytes, KiB(64)), MiB(1024)) & ~static_cast<u64>(7);
+        if (!m_file.open(path, size_bytes))
+            return false;
+
+        const u64 available = size_bytes - sizeof(Header);
+        const u64 site_capacity = (available / 16) & ~static_cast<u64>(7);
+
+        m_header = reinterpret_cast<Header*>(m_file.data());
+        *m_header = {
+            .magic = file_magic,
+            .version = file_version,
+            .entry_size = sizeof(binary_log::Entry),
+            .site_capacity = site_capacity,
+            .ring_capacity = (available - site_capacity) & ~static_cast<u64>(7),
+            .site_used = 0,
+            .head = 0,
+            .tail = 0,
+        };
+        m_sites = m_file.data() + sizeof(Header);
+        m_ring = m_sites + site_capacity;
+
+        m_generation = ++recorder_generation;
+        m_next_site_id = 0;
+        m_entry.reserve(KiB(1));
+        return true;
+    }
+
+    void FlightRecorder::close() {
+        m_file.close();
+        m_header = nullptr;
+        m_sites = nullptr;
+        m_ring = nullptr;
+    }
+
+    void FlightRecorder::append(const LoggingSystem::LogRecord& record, const u8* payload, u64 size_bytes) {
+        m_entry.clear();
+
+        if (record.site == nullptr) {
+            binary_log::append_text(m_entry, record.level, record.timestamp_ns, std::string_view(record.file, record.file_size),
+                                    record.line, std::string_view(reinterpret_cast<const char*>(payload), size_bytes));
+            append_entry(m_entry);
+            return;
+        }
+
+        LogSite& site = *record.site;
+        if (site.recorder_generation != m_generation) {
+            binary_log::append_site(m_entry, m_next_site_id, site);
+
+            std::atomic_ref<u64> site_used(m_header->site_used);
+            const u64 used = site_used.load(std::memory_order_relaxed);
+            if (used + m_entry.size() <= m_header->site_capacity) {
+                std::memcpy(m_sites + used, m_entry.data(), m_entry.size());
+                site_used.store(used + m_entry.size(), std::memory_order_release);
+
+                site.recorder_id = m_next_site_id++;
+                site.recorder_generation = m_generation;
+            }
+
+            m_entry.clear();
+        }
+
+        if (site.recorder_generation == m_generation) {
+            binary_log::append_record(m_entry, site.recorder_id, record.level, record.timestamp_ns, payload, size_bytes);
+        } else {
+            // The site area is full, the line keeps its text.
+            m_message.clear();
+            binary_log::format_arguments(site.format, payload, size_bytes, m_message);
+            binary_log::append_text(m_entry, record.level, record.timestamp_ns, site.file, site.line, m_message);
+        }
+
+        append_entry(m_entry);
+    }
+
+    void FlightRecorder::append_entry(const std::string& entry) {
+        const u64 capacity = m_header->ring_capacity;
+        const u64 size_bytes = align_entry(entry.size());
+        if (size_bytes > capacity)
+            return;
+
+        std::atomic_ref<u64> head(m_header->head);
+        std::atomic_ref<u64> tail(m_header->tail);
+
+        // Moves tail past the entries the next size bytes overwrite.
+        auto make_room = [&](u64 position, u64 size) {
+            u64 oldest = tail.load(std::memory_order_relaxed);
+            while (position + size - oldest > capacity) {
+                u32 oldest_size;
+                std::memcpy(&oldest_size, m_ring + oldest % capacity, sizeof(oldest_size));
+                oldest += align_entry(oldest_size);
+            }
+            tail.store(oldest, std::memory_order_release);
+        };
+
+        u64 position = head.load(std::memory_order_relaxed);
+        u64 offset = position % capacity;
+
+        if (offset + size_bytes > capacity) {
+            const u32 padding = static_cast<u32>(capacity - offset);
+            make_room(position, padding);
+            std::memcpy(m_ring + offset, &padding, sizeof(padding));
+            m_ring[offset + offsetof(binary_log::Entry, kind)] = static_cast<u8>(binary_log::EntryKind::Padding);
+
+            position += padding;
+            head.store(position, std::memory_order_release);
+            offset = 0;
+        }
+
+        make_room(position, size_bytes);
+        std::memcpy(m_ring + offset, entry.data(), entry.size());
+        head.store(position + size_bytes, std::memory_order_release);
+    }
+
+    bool FlightRecorder::decode_file(cstr path, std::string& out) {
+        File file;
+        if (!file.open(path, FileMode::Read, true))
+            return false;
+
+        u8* data = nullptr;
+        u64 size_bytes = 0;
+        const bool read = file.read_all_bytes(&data, &size_bytes);
+
+        Header header = {};
+        if (read && size_bytes >= sizeof(Header)) {
+            std::memcpy(&header, data, sizeof(Header));
+        }
+
+        const u64 capacity = header.ring_capacity;
+        const bool valid_header = header.magic == file_magic && header.version == file_version && header.entry_size == sizeof(binary_log::Entry) &&
+                                  capacity % 8 == 0 && sizeof(Header) + header.site_capacity + capacity <= size_bytes &&
+                                  header.site_used <= header.site_capacity && header.tail <= header.head && header.head - header.tail <= capacity;
+        if (!valid_header) {
+            ErrorLog("nk::FlightRecorder::decode_file {} is not a flight recorder of version {}.", path, file_version);
+            if (data != nullptr) {
+                native_free_lot(u8, data, size_bytes);
+            }
+            return false;
+        }
+
+        const u8* sites = data + sizeof(Header);
+        const u8* ring = sites + header.site_capacity;
+
+        // Walks the ring from tail to head, false as soon as an entry does
+        // not fit it.
+        auto for_each_entry = [&](auto&& callback) {
+            u64 position = header.tail;
+            while (position < header.head) {
+                const u64 offset = position % capacity;
+                binary_log::Entry entry = {};
+                std::memcpy(&entry, ring + offset, MinValue(sizeof(binary_log::Entry), capacity - offset));
+
+                if (entry.kind == binary_log::EntryKind::Padding) {
+                    if (entry.size < 8 || offset + entry.size != capacity)
+                        return false;
+                    position += entry.size;
+                    continue;
+                }
+
+                if (entry.size < sizeof(binary_log::Entry) || offset + entry.size > capacity)
+                    return false;
+
+                callback(entry, offset);
+                position += align_entry(entry.size);
+            }
+            return true;
+        };
+
+        struct Span {
+            i64 timestamp_ns;
+            u64 offset;
+            u32 size_bytes;
+        };
+
+        u64 count = 0;
+        const bool valid = for_each_entry([&](const binary_log::Entry&, u64) { count++; });
+
+        Span* spans = count > 0 ? native_allocate_lot(Span, count) : nullptr;
+        u64 index = 0;
+        for_each_entry([&](const binary_log::Entry& entry, u64 offset) {
+            spans[index++] = {.timestamp_ns = entry.timestamp_ns, .offset = offset, .size_bytes = entry.size};
+        });
+
+        // The writer groups lines by thread, time puts them back in order.
+        std::stable_sort(spans, spans + count, [](const Span& a, const Span& b) { return a.timestamp_ns < b.timestamp_ns; });
+
+        // Sites first, binary_log::decode wants them before their records.
+        std::string stream;
+        stream.reserve(header.site_used + (header.head - header.tail));
+        stream.append(reinterpret_cast<const char*>(sites), header.site_used);
+        for (u64 i = 0; i < count; i++) {
+            stream.append(reinterpret_cast<const char*>(ring + spans[i].offset), spans[i].size_bytes);
+        }
+
+        if (spans != nullptr) {
+            native_free_lot(Span, spans, count);
+        }
+        native_free_lot(u8, data, size_bytes);
+
+        const bool decoded = binary_log::decode(reinterpret_cast<const u8*>(stream.data()), stream.size(), out);
+        return valid && decoded;
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "platform/mapped_file.h"
+
+namespace nk {
+    // Keeps the most recent log records, binary and at every level, in a
+    // mapped file. The OS writes the pages back even when the process dies,
+    // so after a crash the file holds the last lines before it. A file left
+    // by a previous run is renamed to <stem>.previous<ext> first.
+    //
+    // Layout: a Header, a site area where every call site is written once,
+    // then a ring of binary_log entries. Entries start 8 byte aligned and
+    // never wrap, a Padding entry fills the end instead. Only the writer
+    // thread appends.
+    class FlightRecorder {
+    public:
+        struct Header {
+            u32 magic;
+            u16 version;
+            u16 entry_size;
+            u64 site_capacity;
+            u64 ring_capacity;
+            u64 site_used;
+            // Bytes ever written to the ring, the oldest whole entry starts at
+            // tail. tail moves before an entry is overwritten, head after the
+            // new one is complete, so a crash leaves a readable ring.
+            u64 head;
+            u64 tail;
+        };
+
+        static constexpr u32 file_magic = 0x52464B4E; // "NKFR"
+        static constexpr u16 file_version = 1;
+
+        bool open(cstr path, u64 size_bytes);
+        void close();
+
+        void append(const LoggingSystem::LogRecord& record, const u8* payload, u64 size_bytes);
+
+        // Lines of the ring from oldest to newest, like binary_log::decode
+        // prints them.
+        static bool decode_file(cstr path, std::string& out);
+
+    private:
+        void append_entry(const std::string& entry);
+
+        MappedFile m_file;
+        Header* m_header = nullptr;
+        u8* m_sites = nullptr;
+        u8* m_ring = nullptr;
+        // Sites of other recorders, or of this one before a reopen, are not
+        // in the site area.
+        u32 m_generation = 0;
+        u32 m_next_site_id = 0;
+        std::string m_entry;
+        std::string m_message;
+    };
+}
@@ -3,22 +3,23 @@
 #include "systems/input_system.h"
 
 #include "systems/event_system.h"
+#include "systems/event_recorder.h"
 
 namespace nk {
     bool InputSystem::is_key_down(KeyCodeFlag keycode) {
-        return m_current_keyboard_state.keys[keycode] == true;
+        return m_current_keyboard_state.keys.test(keycode);
     }
 
     bool InputSystem::is_key_up(KeyCodeFlag keycode) {
-        return m_current_keyboard_state.keys[keycode] == false;
+        return !m_current_keyboard_state.keys.test(keycode);
     }
 
     bool InputSystem::was_key_down(KeyCodeFlag keycode) {
-        return m_previous_keyboard_state.keys[keycode] == true;
+        return m_previous_keyboard_state.keys.test(keycode);
     }
 
     bool InputSystem::was_key_up(KeyCodeFlag keycode) {
-        return m_previous_keyboard_state.keys[keycode] == false;
+        return !m_previous_keyboard_state.keys.test(keycode);
     }
 
     bool InputSystem::is_mouse_button_down(MouseButton button) {
@@ -48,23 +49,105 @@ namespace nk {
     }
 
     void InputSystem::update_impl(f64 delta_time) {
-        memcpy(&m_previous_keyboard_state, &m_current_keyboard_state, sizeof(KeyboardState));
-        memcpy(&m_previous_mouse_state, &m_current_mouse_state, sizeof(MouseState));
+        m_previous_keyboard_state = m_current_keyboard_state;
+        m_previous_mouse_state = m_current_mouse_state;
+    }
+
+    InputAction InputSystem::bind_action(u64 action_id, std::initializer_list<KeyCodeFlag> chord) {
+        InputSystem& instance = get();
+
+        if (chord.size() == 0) {
+            ErrorLog("nk::InputSystem::bind_action Empty chord for action {:#x}.", action_id);
+            return invalid_action;
+        }
+
+        InputAction action = find_action(action_id);
+        if (action.index == invalid_action.index) {
+            if (instance.m_action_ids.length() == max_actions) {
+                ErrorLog("nk::InputSystem::bind_action Reached the limit of {} actions.", max_actions);
+                return invalid_action;
+            }
+
+            action.index = static_cast<u16>(instance.m_action_ids.length());
+            instance.m_action_ids.static_arr_push_copy(action_id);
+        }
+
+        if (instance.m_bindings.length() == max_bindings) {
+            ErrorLog("nk::InputSystem::bind_action Reached the limit of {} bindings.", max_bindings);
+            return invalid_action;
+        }
+
+        ActionBinding binding = {.action = action.index};
+        for (KeyCodeFlag keycode : chord) {
+            Assert(keycode < key_count);
+            binding.chord.set(keycode);
+        }
+        instance.m_bindings.static_arr_push_copy(binding);
+
+        return action;
+    }
+
+    InputAction InputSystem::find_action(u64 action_id) {
+        const InputSystem& instance = get();
+
+        for (u64 i = 0; i < instance.m_action_ids.length(); i++) {
+            if (instance.m_action_ids[i] == action_id)
+                return InputAction{.index = static_cast<u16>(i)};
+        }
+
+        return invalid_action;
+    }
+
+    void InputSystem::clear_actions() {
+        InputSystem& instance = get();
+
+        instance.m_action_ids.static_arr_reset();
+        instance.m_bindings.static_arr_reset();
+        instance.m_action_down.reset_all();
+        instance.m_action_pressed.reset_all();
+        instance.m_action_released.reset_all();
+    }
+
+    void InputSystem::evaluate_actions_impl() {
+        const KeyBits& current = m_current_keyboard_state.keys;
+        const KeyBits& previous = m_previous_keyboard_state.keys;
+
+        const KeyBits changed_keys = current ^ previous;
+        m_pressed_keys = changed_keys & current;
+        m_released_keys = changed_keys & previous;
+
+        const ActionBits was_down = m_action_down;
+        m_action_down.reset_all();
+        for (u64 i = 0; i < m_bindings.length(); i++) {
+            const ActionBinding& binding = m_bindings[i];
+            if ((current & binding.chord) == binding.chord)
+                m_action_down.set(binding.action);
+        }
+
+        const ActionBits changed_actions = m_action_down ^ was_down;
+        m_action_pressed = changed_actions & m_action_down;
+        m_action_released = changed_actions & was_down;
     }
 
     void InputSystem::process_key_impl(KeyCodeFlag keycode, bool pressed) {
-        if (m_current_keyboard_state.keys[keycode] == pressed)
+        if (EventRecorder::drops_live_input())
+            return;
+
+        if (keycode >= key_count || m_current_keyboard_state.keys.test(keycode) == pressed)
             return;
 
-        m_current_keyboard_state.keys[keycode] = pressed;
+        m_current_keyboard_state.keys.set(keycode, pressed);
 
         const SystemEventCode code = pressed ? SystemEventCode::KeyPressed : SystemEventCode::KeyReleased;
         EventContext context;
         context.data.u16[0] = keycode;
-        EventSystem::fire_event(code, nullptr, context);
+        EventSystem::post_event(code, nullptr, context);
     }
 
     void InputSystem::process_mouse_button_impl(MouseButton button, bool pressed) {
+        if (EventRecorder::drops_live_input())
+            return;
+
         const u8 button_value = static_cast<u8>(button);
 
         if (m_current_mouse_state.buttons[button_value] == pressed)
@@ -75,25 +158,137 @@ namespace nk {
         const SystemEventCode code = pressed ? SystemEventCode::ButtonPressed : SystemEventCode::ButtonReleased;
         EventContext context;
         context.data.u8[0] = button_value;
-        EventSystem::fire_event(code, nullptr, context);
+        EventSystem::post_event(code, nullptr, context);
     }
 
-    void InputSystem::process_mouse_move_impl(i16 x, i16 y) {
+    void InputSystem::process_mouse_move_impl(i16 x, i16 y, u64 timestamp_ns) {
+        if (EventRecorder::drops_live_input())
+            return;
+
         if (m_current_mouse_state.x == x && m_current_mouse_state.y == y)
             return;
 
         m_current_mouse_state.x = x;
         m_current_mouse_state.y = y;
 
+        m_motion[m_motion_count % motion_history_capacity] = {.timestamp_ns = timestamp_ns, .x = x, .y = y};
+        m_motion_count++;
+
         EventContext context;
         context.data.i16[0] = x;
         context.data.i16[1] = y;
-        EventSystem::fire_event(SystemEventCode::MouseMoved, nullptr, context);
+        EventSystem::post_event(SystemEventCode::MouseMoved, nullptr, context);
     }
 
     void InputSystem::process_mouse_wheel_impl(i8 z_delta) {
+        if (EventRecorder::drops_live_input())
+            return;
+
         EventContext context;
         context.data.i8[0] = z_delta;
-        EventSystem::fire_event(SystemEventCode::MouseWheel, nullptr, context);
+        EventSystem::post_event(SystemEventCode::MouseWheel, nullptr, context);
+    }
+
+    bool InputSystem::start_sampling(PFN_SampleInput sample, void* user_data, u32 frequency_hz) {
+        InputSystem& instance = get();
+
+        if (frequency_hz == 0) {
+            ErrorLog("nk::InputSystem::start_sampling Frequency must be above zero.");
+            return false;
+        }
+
+        if (instance.m_sampling.exchange(true, std::memory_order_acq_rel)) {
+            WarnLog("nk::InputSystem::start_sampling Already sampling.");
+            return false;
+        }
+
+        instance.m_sampler = std::thread(&InputSystem::sample_loop, &instance, sample, user_data, frequency_hz);
+
+        InfoLog("nk::InputSystem Sampling input at {} Hz.", frequency_hz);
+        return true;
+    }
+
+    void InputSystem::stop_sampling() {
+        InputSystem& instance = get();
+
+        instance.m_sampling.store(false, std::memory_order_release);
+        if (instance.m_sampler.joinable()) {
+            instance.m_sampler.join();
+        }
+    }
+
+    void InputSystem::sample_loop(PFN_SampleInput sample, void* user_data, u32 frequency_hz) {
+        const std::chrono::nanoseconds period(1'000'000'000ull / frequency_hz);
+        std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+
+        // sleep_until against a fixed schedule so the time spent sampling
+        // does not stretch the period. How close it gets to the frequency is
+        // up to the OS timer resolution.
+        while (m_sampling.load(std::memory_order_acquire)) {
+            sample(user_data);
+
+            next += period;
+            std::this_thread::sleep_until(next);
+        }
+    }
+
+    void InputSystem::consume_samples_impl() {
+        const u64 now = timestamp_ns();
+
+        InputSample sample;
+        while (m_samples.mpsc_queue_pop(sample)) {
+            const u64 latency = now > sample.timestamp_ns ? now - sample.timestamp_ns : 0;
+            m_queue_latency.sample_count++;
+            m_queue_latency.total_ns += latency;
+            m_queue_latency.max_ns = MaxValue(m_queue_latency.max_ns, latency);
+
+            switch (sample.kind) {
+                case InputSample::Kind::Key:
+                    process_key_impl(sample.keycode, sample.pressed);
+                    break;
+                case InputSample::Kind::MouseButton:
+                    process_mouse_button_impl(sample.button, sample.pressed);
+                    break;
+                case InputSample::Kind::MouseMove:
+                    process_mouse_move_impl(sample.x, sample.y, sample.timestamp_ns);
+                    break;
+                case InputSample::Kind::MouseWheel:
+                    process_mouse_wheel_impl(sample.z_delta);
+                    break;
+            }
+        }
+    }
+
+    u64 InputSystem::motion_history(MotionSample* out_samples, u64 max_count) const {
+        const u64 count = MinValue(max_count, MinValue(m_motion_count, motion_history_capacity));
+
+        for (u64 i = 0; i < count; i++) {
+            out_samples[i] = m_motion[(m_motion_count - count + i) % motion_history_capacity];
+        }
+
+        return count;
+    }
+
+    bool InputSystem::predict_mouse_position(u64 at_ns, i16& out_x, i16& out_y) const {
+        out_x = m_current_mouse_state.x;
+        out_y = m_current_mouse_state.y;
+
+        if (m_motion_count < 2)
+            return false;
+
+        const MotionSample& last = m_motion[(m_motion_count - 1) % motion_history_capacity];
+        const MotionSample& before = m_motion[(m_motion_count - 2) % motion_history_capacity];
+        if (last.timestamp_ns <= before.timestamp_ns || at_ns <= last.timestamp_ns)
+            return false;
+
+        const f64 t = static_cast<f64>(at_ns - last.timestamp_ns) / static_cast<f64>(last.timestamp_ns - before.timestamp_ns);
+        const f64 x = last.x + (last.x - before.x) * t;
+        const f64 y = last.y + (last.y - before.y) * t;
+
+        constexpr f64 lowest = std::numeric_limits<i16>::min();
+        constexpr f64 highest = std::numeric_limits<i16>::max();
+        out_x = static_cast<i16>(MaxValue(MinValue(x, highest), lowest));
+        out_y = static_cast<i16>(MaxValue(MinValue(y, highest), lowest));
+        return true;
     }
 }
@@ -1,12 +1,28 @@
 #pragma once
 
 #include "core/input_codes.h"
+#include "collections/bitset.h"
+#include "collections/static_arr.h"
+#include "collections/mpsc_queue.h"
 
 namespace nk {
     class InputSystem {
     public:
+        static constexpr u16 key_count = 256;
+        static constexpr u16 max_actions = 64;
+        static constexpr u16 max_bindings = 128;
+        static constexpr u64 sample_queue_capacity = 1024;
+        static constexpr u64 motion_history_capacity = 64;
+
+        static constexpr InputAction invalid_action = {
+            .index = std::numeric_limits<u16>::max(),
+        };
+
+        using KeyBits = cl::bitset<key_count>;
+        using ActionBits = cl::bitset<max_actions>;
+
         struct KeyboardState {
-            bool keys[256];
+            KeyBits keys;
         };
 
         struct MouseState {
@@ -15,6 +31,43 @@ namespace nk {
             bool buttons[static_cast<u8>(MouseButton::MaxButtons)];
         };
 
+        // Device state read by a sampling thread, stamped with the time it
+        // was read rather than the time the frame got to it.
+        struct InputSample {
+            enum class Kind : u8 {
+                Key,
+                MouseButton,
+                MouseMove,
+                MouseWheel,
+            };
+
+            u64 timestamp_ns;
+            Kind kind;
+            bool pressed;
+            i8 z_delta;
+            MouseButton button;
+            KeyCodeFlag keycode;
+            i16 x;
+            i16 y;
+        };
+
+        struct MotionSample {
+            u64 timestamp_ns;
+            i16 x;
+            i16 y;
+        };
+
+        // Time samples waited in the sample queue, from being read to the
+        // frame applying them. Only that part of the input latency, the OS
+        // before the read and the frame after are not in it.
+        struct QueueLatencyStats {
+            u64 sample_count;
+            u64 total_ns;
+            u64 max_ns;
+        };
+
+        using PFN_SampleInput = void (*)(void* user_data);
+
         ~InputSystem() = default;
 
         static InputSystem& init() {
@@ -23,6 +76,7 @@ namespace nk {
         }
 
         static void shutdown() {
+            stop_sampling();
             TraceLog("nk::InputSystem Shutdown.");
         }
 
@@ -35,9 +89,63 @@ namespace nk {
 
         static void process_key(KeyCodeFlag keycode, bool pressed) { get().process_key_impl(keycode, pressed); }
         static void process_mouse_button(MouseButton button, bool pressed) { get().process_mouse_button_impl(button, pressed); }
-        static void process_mouse_move(i16 x, i16 y) { get().process_mouse_move_impl(x, y); }
+        static void process_mouse_move(i16 x, i16 y) { get().process_mouse_move_impl(x, y, timestamp_ns()); }
         static void process_mouse_wheel(i8 z_delta) { get().process_mouse_wheel_impl(z_delta); }
 
+        // Monotonic, the clock every sample and motion timestamp is read from.
+        static u64 timestamp_ns() {
+            return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        // Safe from any thread and never blocks, false when the queue is full.
+        // Samples are applied on the main thread by consume_samples.
+        static bool push_sample(const InputSample& sample) { return get().m_samples.mpsc_queue_push(sample); }
+
+        // Starts a thread calling sample every 1 / frequency_hz seconds, the
+        // callback reads the devices and pushes what changed. The thread is
+        // optional, the platform messages keep working without it. Samples
+        // are still applied once per frame, so the input does not reach the
+        // frame any sooner. What it adds is timestamps and the motion history
+        // predict_mouse_position extrapolates from.
+        static bool start_sampling(PFN_SampleInput sample, void* user_data, u32 frequency_hz);
+        static void stop_sampling();
+        static bool sampling() { return get().m_sampling.load(std::memory_order_relaxed); }
+
+        // Main thread, once per frame while the EventRecorder captures so
+        // the sampled input is recorded like the platform messages.
+        static void consume_samples() { get().consume_samples_impl(); }
+
+        // Copies up to max_count of the latest mouse positions, oldest first,
+        // and returns how many were copied. Several can land between frames.
+        u64 motion_history(MotionSample* out_samples, u64 max_count) const;
+        // Extrapolates the cursor to at_ns from the velocity of the last two
+        // motion samples. False, with the current position, without two.
+        bool predict_mouse_position(u64 at_ns, i16& out_x, i16& out_y) const;
+
+        void reset_motion_history() { m_motion_count = 0; }
+
+        QueueLatencyStats queue_latency_stats() const { return m_queue_latency; }
+        void reset_queue_latency_stats() { m_queue_latency = {}; }
+
+        // Binds a chord, every key held at once, to the action with the given
+        // id, usually hash::string of its name. An action can have several
+        // chords and is down while any of them is held.
+        static InputAction bind_action(u64 action_id, std::initializer_list<KeyCodeFlag> chord);
+        static InputAction find_action(u64 action_id);
+        static void clear_actions();
+
+        // Computes the key edges and every action state in one pass, once per
+        // frame before the app update. The queries below only test a bit.
+        static void evaluate_actions() { get().evaluate_actions_impl(); }
+
+        bool is_action_down(InputAction action) const { return action.index < max_actions && m_action_down.test(action.index); }
+        bool is_action_pressed(InputAction action) const { return action.index < max_actions && m_action_pressed.test(action.index); }
+        bool is_action_released(InputAction action) const { return action.index < max_actions && m_action_released.test(action.index); }
+
+        // Went down or up since the previous frame.
+        bool is_key_pressed(KeyCodeFlag keycode) const { return keycode < key_count && m_pressed_keys.test(keycode); }
+        bool is_key_released(KeyCodeFlag keycode) const { return keycode < key_count && m_released_keys.test(keycode); }
+
         bool is_key_down(KeyCodeFlag keycode);
         bool is_key_up(KeyCodeFlag keycode);
         bool was_key_down(KeyCodeFlag keycode);
@@ -54,19 +162,47 @@ namespace nk {
         KeyboardState get_previous_keyboard_state() const { return m_previous_keyboard_state; }
 
     private:
+        struct ActionBinding {
+            KeyBits chord;
+            u16 action;
+        };
+
         InputSystem() = default;
 
         void update_impl(f64 delta_time);
+        void evaluate_actions_impl();
 
         void process_key_impl(KeyCodeFlag keycode, bool pressed);
         void process_mouse_button_impl(MouseButton button, bool pressed);
-        void process_mouse_move_impl(i16 x, i16 y);
+        void process_mouse_move_impl(i16 x, i16 y, u64 timestamp_ns);
         void process_mouse_wheel_impl(i8 z_delta);
 
+        void consume_samples_impl();
+        void sample_loop(PFN_SampleInput sample, void* user_data, u32 frequency_hz);
+
         KeyboardState m_current_keyboard_state;
         KeyboardState m_previous_keyboard_state;
 
         MouseState m_current_mouse_state;
         MouseState m_previous_mouse_state;
+
+        KeyBits m_pressed_keys;
+        KeyBits m_released_keys;
+
+        cl::static_arr<u64, max_actions> m_action_ids;
+        cl::static_arr<ActionBinding, max_bindings> m_bindings;
+        ActionBits m_action_down;
+        ActionBits m_action_pressed;
+        ActionBits m_action_released;
+
+        cl::mpsc_queue<InputSample, sample_queue_capacity> m_samples;
+        std::thread m_sampler;
+        std::atomic<bool> m_sampling;
+        QueueLatencyStats m_queue_latency;
+
+        // Ring of the latest positions, m_motion_count keeps counting past
+        // the capacity.
+        MotionSample m_motion[motion_history_capacity];
+        u64 m_motion_count;
     };
 }
@@ -0,0 +1,202 @@
+#include "nkpch.h"
+
+#include "systems/log_compression.h"
+#include "platform/file.h"
+
+namespace nk::log_compression {
+    static constexpr u64 min_match = 4;
+    static constexpr u64 max_offset = 65535;
+    static constexpr u32 hash_bits = 14;
+
+    static u32 read_u32(const u8* data) {
+        u32 value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    static u32 hash(u32 value) {
+        return (value * 2654435761u) >> (32 - hash_bits);
+    }
+
+    static void append_length(std::string& out, u64 length) {
+        while (length >= 255) {
+            out.push_back(static_cast<char>(255));
+            length -= 255;
+        }
+        out.push_back(static_cast<char>(length));
+    }
+
+    // A match_length of 0 makes it the last sequence.
+    static void append_sequence(std::string& out, const u8* literals, u64 literal_count, u64 offset, u64 match_length) {
+        const u64 match_code = match_length == 0 ? 0 : match_length - min_match;
+        out.push_back(static_cast<char>((MinValue(literal_count, 15) << 4) | MinValue(match_code, 15)));
+
+        if (literal_count >= 15) {
+            append_length(out, literal_count - 15);
+        }
+        out.append(reinterpret_cast<const char*>(literals), literal_count);
+
+        if (match_length == 0)
+            return;
+
+        const u16 offset_bytes = static_cast<u16>(offset);
+        out.append(reinterpret_cast<const char*>(&offset_bytes), sizeof(offset_bytes));
+        if (match_code >= 15) {
+            append_length(out, match_code - 15);
+        }
+    }
+
+    static bool read_length(const u8* data, u64 size_bytes, u64& offset, u64& length) {
+        u8 byte;
+        do {
+            if (offset >= size_bytes)
+                return false;
+            byte = data[offset++];
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+
+    void compress(const u8* data, u64 size_bytes, std::string& out) {
+        // Last position of every hashed 4 bytes, a stale one fails the compare.
+        u32 table[1 << hash_bits] = {};
+
+        u64 anchor = 0;
+        u64 i = 0;
+        while (i + min_match <= size_bytes) {
+            const u32 value = read_u32(data + i);
+            const u32 slot = hash(value);
+            const u64 candidate = table[slot];
+            table[slot] = static_cast<u32>(i);
+
+            if (candidate >= i || i - candidate > max_offset || read_u32(data + candidate) != value) {
+                i++;
+                continue;
+            }
+
+            u64 length = min_match;
+            while (i + length < size_bytes && data[candidate + length] == data[i + length]) {
+                length++;
+            }
+
+            append_sequence(out, data + anchor, i - anchor, i - candidate, length);
+            i += length;
+            anchor = i;
+        }
+
+        append_sequence(out, data + anchor, size_bytes - anchor, 0, 0);
+    }
+
+    bool decompress(const u8* data, u64 size_bytes, std::string& out) {
+        u64 i = 0;
+        while (i < size_bytes) {
+            const u8 token = data[i++];
+
+            u64 literal_count = token >> 4;
+            if (literal_count == 15 && !read_length(data, size_bytes, i, literal_count))
+                return false;
+            if (i + literal_count > size_bytes)
+                return false;
+
+            out.append(reinterpret_cast<const char*>(data + i), literal_count);
+            i += literal_count;
+            if (i == size_bytes)
+                return true;
+
+            u16 offset;
+            if (i + sizeof(offset) > size_bytes)
+                return false;
+            std::memcpy(&offset, data + i, sizeof(offset));
+            i += sizeof(offset);
+
+            u64 match_length = token & 15;
+            if (match_length == 15 && !read_length(data, size_bytes, i, match_length))
+                return false;
+            match_length += min_match;
+
+            if (offset == 0 || offset > out.size())
+                return false;
+
+            // Byte by byte, a match may overlap what it writes.
+            const u64 from = out.size() - offset;
+            for (u64 j = 0; j < match_length; j++) {
+                out.push_back(out[from + j]);
+            }
+        }
+
+        return false;
+    }
+
+    static bool read_file(cstr path, std::string& out) {
+        std::error_code error;
+        const u64 size_bytes = std::filesystem::file_size(path, error);
+        if (error)
+            return false;
+
+        File file;
+        if (!file.open(path, FileMode::Read, true))
+            return false;
+
+        out.resize(size_bytes);
+        u64 read;
+        return size_bytes == 0 || file.read(size_bytes, out.data(), &read);
+    }
+
+    bool compress_file(cstr path) {
+        std::string input;
+        if (!read_file(path, input)) {
+            ErrorLog("nk::log_compression::compress_file Could not read {}.", path);
+            return false;
+        }
+
+        const FileHeader header = {
+            .magic = file_magic,
+            .version = file_version,
+            .reserved = 0,
+            .size_bytes = input.size(),
+        };
+
+        std::string output;
+        output.reserve(sizeof(header) + input.size() / 2);
+        output.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        compress(reinterpret_cast<const u8*>(input.data()), input.size(), output);
+
+        const std::string output_path = std::string(path) + file_extension;
+        bool written;
+        {
+            File file;
+            u64 bytes_written;
+            written = file.open(output_path.c_str(), FileMode::Write, true) && file.write(output.size(), output.data(), &bytes_written);
+        }
+
+        std::error_code error;
+        if (!written) {
+            std::filesystem::remove(output_path, error);
+            return false;
+        }
+
+        std::filesystem::remove(path, error);
+        return true;
+    }
+
+    bool decompress_file(cstr path, std::string& out) {
+        std::string input;
+        if (!read_file(path, input))
+            return false;
+
+        FileHeader header = {};
+        if (input.size() >= sizeof(FileHeader)) {
+            std::memcpy(&header, input.data(), sizeof(FileHeader));
+        }
+
+        if (header.magic != file_magic || header.version != file_version) {
+            ErrorLog("nk::log_compression::decompress_file {} is not a compressed log of version {}.", path, file_version);
+            return false;
+        }
+
+        const u64 start = out.size();
+        out.reserve(start + header.size_bytes);
+        const bool decompressed = decompress(reinterpret_cast<const u8*>(input.data()) + sizeof(FileHeader), input.size() - sizeof(FileHeader), out);
+        return decompressed && out.size() - start == header.size_bytes;
+    }
+}
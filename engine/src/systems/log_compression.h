@@ -0,0 +1,28 @@
+#pragma once
+
+namespace nk::log_compression {
+    // A compressed log is a FileHeader and one LZ77 stream of sequences. A
+    // sequence is a token with the literal count in the high nibble and the
+    // match length minus min_match in the low one, the literals, then a u16
+    // offset back into the output. A nibble of 15 continues in bytes of up
+    // to 255, the literal one before the literals, the match one after the
+    // offset. The last sequence stops after its literals.
+    struct FileHeader {
+        u32 magic;
+        u16 version;
+        u16 reserved;
+        u64 size_bytes;
+    };
+
+    static constexpr u32 file_magic = 0x5A4C4B4E; // "NKLZ"
+    static constexpr u16 file_version = 1;
+    static constexpr cstr file_extension = ".lz";
+
+    void compress(const u8* data, u64 size_bytes, std::string& out);
+    // False on a malformed stream, with what was decoded up to it in out.
+    bool decompress(const u8* data, u64 size_bytes, std::string& out);
+
+    // Writes path + file_extension and removes path once it is complete.
+    bool compress_file(cstr path);
+    bool decompress_file(cstr path, std::string& out);
+}
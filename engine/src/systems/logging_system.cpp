@@ -1,11 +1,60 @@
 #include "nkpch.h"
 
 #include "systems/logging_system.h"
+#include "systems/binary_log.h"
+#include "systems/file_log_sink.h"
+#include "systems/flight_recorder.h"
+#include "platform/file.h"
 
 namespace nk {
+    // stdout, with the colors of the levels.
+    class ConsoleLogSink final : public LogSink {
+    public:
+        void write(std::string_view lines) override {
+            os::write(lines.data(), lines.size());
+            m_pending = true;
+        }
+
+        void idle() override {
+            if (m_pending) {
+                flush();
+            }
+        }
+
+        void flush() override {
+            os::flush();
+            m_pending = false;
+        }
+
+        bool colored() const override { return true; }
+
+    private:
+        bool m_pending = false;
+    };
+
+    static ConsoleLogSink console_sink;
+
+    // Set while the thread writes to the sinks. A line a sink logs itself,
+    // like a file that failed to open, goes straight to the console.
+    static thread_local bool writing_sinks = false;
+
+    // TODO: Move to a more generalized place
+    std::string get_project_path() {
+#ifdef NK_PROJECT_PATH
+        // Already stripped by log_file.
+        return {};
+#else
+        return std::filesystem::current_path().string();
+#endif
+    }
+
     LoggingSystem& LoggingSystem::init(const LoggingSystemConfig& config) {
         LoggingSystem& instance = get();
 
+        if (instance.m_async || instance.m_sink_count > 0) {
+            shutdown();
+        }
+
         for (u8 i = 0; i < static_cast<u8>(LoggingLevel::Off); i++) {
             LoggingColor color = config.style[i];
             if (color.bg) {
@@ -18,10 +67,68 @@ namespace nk {
             }
         }
 
-        instance.m_priority = config.priority;
+        instance.m_project_path = get_project_path();
         instance.m_show_file = config.show_file;
         instance.m_show_time = config.show_time;
-        instance.m_file_output = config.file_output;
+
+        // A burst of n lines empties the bucket n - 1 intervals ahead.
+        instance.m_rate_interval_ns = config.rate_limit_per_second > 0 ? 1'000'000'000 / config.rate_limit_per_second : 0;
+        instance.m_rate_burst_ns = instance.m_rate_interval_ns * (MaxValue(config.rate_limit_burst, 1u) - 1);
+
+        instance.m_ring_count.store(0, std::memory_order_relaxed);
+        instance.m_generation.fetch_add(1, std::memory_order_release);
+        instance.m_dropped.store(0, std::memory_order_relaxed);
+        instance.m_dropped_reported = 0;
+        instance.m_batch.reserve(batch_size);
+        instance.m_plain_batch.reserve(batch_size);
+
+        // Binary lines only make sense once they leave the caller thread.
+        if (config.binary_output != nullptr && config.async) {
+            File* file = new File();
+            const binary_log::FileHeader header = {
+                .magic = binary_log::file_magic,
+                .version = binary_log::file_version,
+                .entry_size = sizeof(binary_log::Entry),
+            };
+
+            u64 written;
+            if (file->open(config.binary_output, FileMode::Write, true) && file->write(sizeof(header), &header, &written)) {
+                instance.m_binary_file = file;
+                instance.m_binary_batch.reserve(batch_size);
+                instance.m_binary_generation++;
+                instance.m_next_site_id = 0;
+            } else {
+                delete file;
+            }
+        }
+
+        instance.m_recorder_priority = LoggingLevel::Off;
+        if (config.flight_recorder != nullptr && config.async) {
+            FlightRecorder* recorder = new FlightRecorder();
+            if (recorder->open(config.flight_recorder, config.flight_recorder_size)) {
+                instance.m_flight_recorder = recorder;
+                instance.m_recorder_priority = config.flight_recorder_priority;
+            } else {
+                delete recorder;
+            }
+        }
+        set_priority(config.priority);
+
+        add_sink(&console_sink);
+        if (config.file_output && config.file_path != nullptr) {
+            FileLogSink* sink = new FileLogSink(config);
+            if (sink->open() && add_sink(sink)) {
+                instance.m_file_sink = sink;
+            } else {
+                delete sink;
+            }
+        }
+
+        instance.m_async = config.async;
+        if (instance.m_async) {
+            instance.m_writer_running.store(true, std::memory_order_release);
+            instance.m_writer = std::thread(&LoggingSystem::writer_loop, &instance);
+        }
 
         TraceLog("nk::LoggingSystem Inititalized.");
 
@@ -29,61 +136,412 @@ namespace nk {
     }
 
     void LoggingSystem::shutdown() {
+        LoggingSystem& instance = get();
+
         TraceLog("nk::LoggingSystem Shutdown.");
+
+        if (instance.m_async) {
+            // Other threads have to be done logging by now, their rings go away.
+            instance.m_writer_running.store(false, std::memory_order_release);
+            instance.m_writer.join();
+            instance.drain(true);
+
+            instance.m_async = false;
+            instance.m_generation.fetch_add(1, std::memory_order_release);
+
+            if (instance.m_binary_file != nullptr) {
+                instance.m_binary_file->close();
+                delete instance.m_binary_file;
+                instance.m_binary_file = nullptr;
+            }
+
+            delete instance.m_flight_recorder;
+            instance.m_flight_recorder = nullptr;
+            instance.m_recorder_priority = LoggingLevel::Off;
+            set_priority(instance.m_priority.load(std::memory_order_relaxed));
+
+            const u32 ring_count = instance.m_ring_count.exchange(0, std::memory_order_acq_rel);
+            for (u32 i = 0; i < ring_count; i++) {
+                delete instance.m_rings[i];
+                instance.m_rings[i] = nullptr;
+            }
+        }
+
+        LogSink* file_sink;
+        {
+            std::lock_guard lock(instance.m_drain_mutex);
+            writing_sinks = true;
+            instance.write_sinks(true);
+            writing_sinks = false;
+
+            instance.m_sink_count = 0;
+            instance.m_colored_sinks = 0;
+            file_sink = instance.m_file_sink;
+            instance.m_file_sink = nullptr;
+        }
+
+        // Outside the lock, lines of its compression thread go to the console.
+        delete file_sink;
     }
 
-    // TODO: Move to a more generalized place
-    std::string get_project_path() {
-#if NK_DEV_MODE <= NK_RELEASE_DEBUG_INFO
-        return NK_PROJECT_PATH;
-#else
-        return std::filesystem::current_path().string();
-#endif
+    void LoggingSystem::set_priority(LoggingLevel priority) {
+        LoggingSystem& instance = get();
+        instance.m_priority.store(priority, std::memory_order_relaxed);
+        instance.m_capture_priority.store(MinValue(priority, instance.m_recorder_priority), std::memory_order_relaxed);
+    }
+
+    bool LoggingSystem::add_sink(LogSink* sink) {
+        LoggingSystem& instance = get();
+        std::lock_guard lock(instance.m_drain_mutex);
+
+        if (instance.m_sink_count == max_sinks)
+            return false;
+
+        instance.m_sinks[instance.m_sink_count++] = sink;
+        if (sink->colored()) {
+            instance.m_colored_sinks++;
+        }
+        return true;
+    }
+
+    void LoggingSystem::remove_sink(LogSink* sink) {
+        // Lines logged before the removal still reach it.
+        flush();
+
+        LoggingSystem& instance = get();
+        std::lock_guard lock(instance.m_drain_mutex);
+
+        for (u32 i = 0; i < instance.m_sink_count; i++) {
+            if (instance.m_sinks[i] != sink)
+                continue;
+
+            if (sink->colored()) {
+                instance.m_colored_sinks--;
+            }
+            for (u32 j = i + 1; j < instance.m_sink_count; j++) {
+                instance.m_sinks[j - 1] = instance.m_sinks[j];
+            }
+            instance.m_sink_count--;
+            return;
+        }
     }
 
     void LoggingSystem::log(LoggingLevel level, std::string_view file, u32 line, std::string_view message) {
-        if (level == LoggingLevel::Off)
+        if (level == LoggingLevel::Off || !enabled(level))
             return;
 
-        const u8 index = static_cast<u8>(level);
         auto& instance = get();
 
-        // Add color
-        const std::string& color = instance.m_style[index];
-        os::write(color.c_str(), color.size());
+        if (LogRing* ring = instance.m_async ? thread_ring() : nullptr; ring && message.size() <= max_ring_message_size) {
+            char* data = begin_record(ring, level, file, line, message.size());
+            if (data != nullptr) {
+                std::memcpy(data, message.data(), message.size());
+                end_record(ring, level, message.size());
+            }
+            return;
+        }
+
+        // Without a ring the line cannot reach the flight recorder.
+        if (level < instance.m_priority.load(std::memory_order_relaxed))
+            return;
+
+        const LogRecord record = {
+            .timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count(),
+            .site = nullptr,
+            .file = file.data(),
+            .file_size = static_cast<u32>(file.size()),
+            .line = line,
+            .level = level,
+        };
 
-        std::string buffer;
-        buffer.reserve(128);
+        if (writing_sinks) {
+            std::string buffer;
+            buffer.reserve(128 + message.size());
+            instance.format_line(record, message, buffer, true);
+            os::write(buffer.data(), buffer.length());
+            return;
+        }
 
-        if (instance.m_show_time) {
-            auto now = std::chrono::system_clock::now();
-            auto time_t = std::chrono::system_clock::to_time_t(now);
-            auto* tm = std::localtime(&time_t);
+        std::lock_guard lock(instance.m_drain_mutex);
+        writing_sinks = true;
+        instance.append_line(record, message);
+        instance.write_sinks(level >= LoggingLevel::Error);
+        writing_sinks = false;
+    }
 
-            buffer.append(std::format("{:02}:{:02}:{:02}", tm->tm_hour, tm->tm_min, tm->tm_sec));
+    void LoggingSystem::log_site(LogSite& site, std::string_view message) {
+        if (LogRing* ring = get().m_async ? thread_ring() : nullptr) {
+            // No arguments, the format of the site is the whole line.
+            if (begin_record(ring, site.level, site.file, site.line, 0, &site) != nullptr) {
+                end_record(ring, site.level, 0);
+            }
+            return;
         }
 
-        if (level != LoggingLevel::None) {
-            const auto& level_string = instance.logging_level[index];
-            buffer.append(level_string.value, level_string.size);
+        log(site.level, site.file, site.line, message);
+    }
+
+    void LoggingSystem::flush() {
+        if (writing_sinks)
+            return;
+
+        LoggingSystem& instance = get();
+
+        if (instance.m_async) {
+            instance.drain(true);
         } else {
-            buffer.append(" ");
+            std::lock_guard lock(instance.m_drain_mutex);
+            writing_sinks = true;
+            instance.write_sinks(true);
+            writing_sinks = false;
+        }
+    }
+
+    LoggingSystem::LogRing* LoggingSystem::thread_ring() {
+        thread_local LogRing* ring = nullptr;
+        thread_local u32 generation = 0;
+
+        if (writing_sinks)
+            return nullptr;
+
+        LoggingSystem& instance = get();
+        const u32 current = instance.m_generation.load(std::memory_order_acquire);
+        if (generation == current)
+            return ring;
+
+        std::lock_guard lock(instance.m_rings_mutex);
+
+        generation = current;
+        ring = nullptr;
+
+        const u32 ring_count = instance.m_ring_count.load(std::memory_order_relaxed);
+        if (ring_count < max_threads) {
+            // Plain new, the logger sits below the memory system and its
+            // rings live until LoggingSystem::shutdown.
+            ring = new LogRing();
+            instance.m_rings[ring_count] = ring;
+            instance.m_ring_count.store(ring_count + 1, std::memory_order_release);
+        }
+
+        return ring;
+    }
+
+    char* LoggingSystem::begin_record(LogRing* ring, LoggingLevel level, std::string_view file, u32 line, u64 message_size, LogSite* site) {
+        u8* data = ring->spsc_ring_reserve(sizeof(LogRecord) + message_size);
+
+        // Errors are worth waiting for, the rest is counted and dropped.
+        while (data == nullptr) {
+            if (level < LoggingLevel::Error) {
+                get().m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            flush();
+            data = ring->spsc_ring_reserve(sizeof(LogRecord) + message_size);
+        }
+
+        *reinterpret_cast<LogRecord*>(data) = {
+            .timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count(),
+            .site = site,
+            .file = file.data(),
+            .file_size = static_cast<u32>(file.size()),
+            .line = line,
+            .level = level,
+        };
+
+        return reinterpret_cast<char*>(data + sizeof(LogRecord));
+    }
+
+    void LoggingSystem::end_record(LogRing* ring, LoggingLevel level, u64 message_size) {
+        ring->spsc_ring_commit(sizeof(LogRecord) + message_size);
+
+        if (level == LoggingLevel::Fatal) {
+            flush();
+        }
+    }
+
+    void LoggingSystem::format_line(const LogRecord& record, std::string_view message, std::string& out, bool colored) {
+        const u8 index = static_cast<u8>(record.level);
+
+        if (colored) {
+            out.append(m_style[index]);
         }
 
-        buffer.append(message);
+        if (m_show_time) {
+            // localtime only once a second, lines in between reuse the text.
+            thread_local i64 cached_second = -1;
+            thread_local char cached_time[8];
 
-        if (instance.m_show_file) {
-            auto project_path = get_project_path();
-            auto pos = file.find(project_path);
+            const i64 second = record.timestamp_ns / 1'000'000'000;
+            if (second != cached_second) {
+                const std::time_t time = static_cast<std::time_t>(second);
+                const std::tm* tm = std::localtime(&time);
+                std::format_to_n(cached_time, sizeof(cached_time), "{:02}:{:02}:{:02}", tm->tm_hour, tm->tm_min, tm->tm_sec);
+                cached_second = second;
+            }
+
+            out.append(cached_time, sizeof(cached_time));
+        }
+
+        out.append(level_prefix(record.level));
+
+        out.append(message);
+
+        if (m_show_file) {
+            const std::string_view file(record.file, record.file_size);
+            const auto pos = m_project_path.empty() ? std::string_view::npos : file.find(m_project_path);
             if (pos != std::string_view::npos) {
-                buffer.append(std::format(" ({}:{})", file.substr(pos + project_path.size() + 1), line));
+                std::format_to(std::back_inserter(out), " ({}:{})", file.substr(pos + m_project_path.size() + 1), record.line);
+            } else {
+                std::format_to(std::back_inserter(out), " ({}:{})", file, record.line);
+            }
+        }
+
+        if (colored) {
+            out.append("\033[0m", 4);
+        }
+        out.push_back('\n');
+    }
+
+    void LoggingSystem::append_line(const LogRecord& record, std::string_view message) {
+        // Without sinks, before init or after shutdown, lines go to the console.
+        if (m_colored_sinks > 0 || m_sink_count == 0) {
+            format_line(record, message, m_batch, true);
+        }
+        if (m_colored_sinks < m_sink_count) {
+            format_line(record, message, m_plain_batch, false);
+        }
+    }
+
+    void LoggingSystem::write_sinks(bool flush) {
+        if (m_sink_count == 0) {
+            os::write(m_batch.data(), m_batch.length());
+            if (flush) {
+                os::flush();
+            }
+        }
+
+        for (u32 i = 0; i < m_sink_count; i++) {
+            LogSink* sink = m_sinks[i];
+            const std::string& batch = sink->colored() ? m_batch : m_plain_batch;
+            if (!batch.empty()) {
+                sink->write(batch);
+            }
+
+            if (flush) {
+                sink->flush();
             } else {
-                buffer.append(std::format(" ({}:{})", file, line));
+                sink->idle();
+            }
+        }
+
+        m_batch.clear();
+        m_plain_batch.clear();
+    }
+
+    void LoggingSystem::writer_loop() {
+        while (m_writer_running.load(std::memory_order_acquire)) {
+            if (!drain(false)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    bool LoggingSystem::drain(bool flush) {
+        std::lock_guard lock(m_drain_mutex);
+        writing_sinks = true;
+
+        bool drained = false;
+        auto write_binary = [this]() {
+            if (!m_binary_batch.empty()) {
+                u64 written;
+                m_binary_file->write(m_binary_batch.length(), m_binary_batch.data(), &written);
+                m_binary_batch.clear();
+            }
+        };
+
+        // Lines of one thread keep their order, lines of different threads
+        // are grouped by thread within a batch.
+        const u32 ring_count = m_ring_count.load(std::memory_order_acquire);
+        for (u32 i = 0; i < ring_count; i++) {
+            LogRing* ring = m_rings[i];
+
+            u64 size_bytes;
+            while (const u8* data = ring->spsc_ring_peek(size_bytes)) {
+                const LogRecord& record = *reinterpret_cast<const LogRecord*>(data);
+                const u8* payload = data + sizeof(LogRecord);
+                const u64 payload_size = size_bytes - sizeof(LogRecord);
+
+                if (m_flight_recorder != nullptr && record.level >= m_recorder_priority) {
+                    m_flight_recorder->append(record, payload, payload_size);
+                }
+
+                // Lines only the flight recorder wanted stop here.
+                const bool output = record.level >= m_priority.load(std::memory_order_relaxed);
+                if (m_binary_file != nullptr && output) {
+                    append_binary(record, payload, payload_size);
+                }
+
+                if (output && (m_binary_file == nullptr || record.level >= LoggingLevel::Error)) {
+                    std::string_view message(reinterpret_cast<const char*>(payload), payload_size);
+                    if (record.site != nullptr) {
+                        m_message.clear();
+                        binary_log::format_arguments(record.site->format, payload, payload_size, m_message);
+                        message = m_message;
+                    }
+                    append_line(record, message);
+                }
+
+                // Errors reach every output before the writer moves on.
+                flush = flush || record.level >= LoggingLevel::Error;
+
+                ring->spsc_ring_release();
+                drained = true;
+
+                if (m_batch.length() >= batch_size || m_plain_batch.length() >= batch_size) {
+                    write_sinks(false);
+                }
+                if (m_binary_batch.length() >= batch_size) {
+                    write_binary();
+                }
             }
         }
 
-        buffer.append("\033[0m\n", 5);
+        const u64 dropped_total = m_dropped.load(std::memory_order_relaxed);
+        const u64 dropped = dropped_total - m_dropped_reported;
+        m_dropped_reported = dropped_total;
+        if (dropped > 0) {
+            if (m_colored_sinks > 0 || m_sink_count == 0) {
+                std::format_to(std::back_inserter(m_batch), "{}{} log lines dropped, the ring of their thread was full.\033[0m\n",
+                               m_style[static_cast<u8>(LoggingLevel::Warning)], dropped);
+            }
+            if (m_colored_sinks < m_sink_count) {
+                std::format_to(std::back_inserter(m_plain_batch), "{} log lines dropped, the ring of their thread was full.\n", dropped);
+            }
+        }
+
+        write_binary();
+        // Also when nothing came, sinks with a buffer flush it once due.
+        write_sinks(flush);
+
+        writing_sinks = false;
+        return drained;
+    }
+
+    void LoggingSystem::append_binary(const LogRecord& record, const u8* payload, u64 size_bytes) {
+        if (record.site == nullptr) {
+            binary_log::append_text(m_binary_batch, record.level, record.timestamp_ns, std::string_view(record.file, record.file_size),
+                                    record.line, std::string_view(reinterpret_cast<const char*>(payload), size_bytes));
+            return;
+        }
+
+        LogSite& site = *record.site;
+        if (site.binary_generation != m_binary_generation) {
+            site.binary_id = m_next_site_id++;
+            site.binary_generation = m_binary_generation;
+            binary_log::append_site(m_binary_batch, site.binary_id, site);
+        }
 
-        os::write(buffer.data(), buffer.length());
+        binary_log::append_record(m_binary_batch, site.binary_id, record.level, record.timestamp_ns, payload, size_bytes);
     }
 }
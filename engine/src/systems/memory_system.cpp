@@ -410,6 +410,8 @@ namespace nk::mem {
 
     void MemorySystem::log(cstr color, cstr msg, std::size_t msg_size) {
         // TODO: Add general mutex for logging std::lock_guard<std::mutex> lock(mutex);
+        // Lines still waiting in the async logger go first.
+        LoggingSystem::flush();
         os::write(color, 19);
         os::write(msg, msg_size);
         os::write("\033[0m\n", 5);
@@ -0,0 +1,218 @@
+#include "nkpch.h"
+
+#include "systems/timer_system.h"
+#include "memory/malloc_allocator.h"
+
+namespace nk {
+    TimerSystem& TimerSystem::init() {
+        TimerSystem& instance = get();
+
+        instance.m_allocator = native_construct(mem::MallocAllocator);
+        instance.m_allocator->allocator_init(mem::MallocAllocator, "TimerSystem", MemoryType::System);
+
+        instance.m_timers.dyarr_init(instance.m_allocator, 64);
+        instance.m_free_head = none;
+        instance.m_pending_head = none;
+        std::memset(instance.m_slots, 0xFF, sizeof(instance.m_slots));
+        instance.m_current_tick = 0;
+        instance.m_active_count = 0;
+        instance.m_time = 0.0;
+        instance.m_updating = false;
+
+        TraceLog("nk::TimerSystem Initialized.");
+        return instance;
+    }
+
+    void TimerSystem::shutdown() {
+        TimerSystem& instance = get();
+
+        instance.m_timers.dyarr_shutdown();
+        native_deconstruct(mem::MallocAllocator, instance.m_allocator);
+        TraceLog("nk::TimerSystem Shutdown.");
+    }
+
+    TimerHandle TimerSystem::schedule(f64 delay_seconds, SystemEventCode code, const EventContext& context, f64 interval_seconds) {
+        TimerSystem& instance = get();
+
+        u32 index = instance.m_free_head;
+        if (index != none) {
+            instance.m_free_head = instance.m_timers[index].next;
+        } else {
+            index = static_cast<u32>(instance.m_timers.length());
+            instance.m_timers.dyarr_push_copy(Timer{.generation = 0});
+        }
+
+        // Counted from the tick being fired inside a callback, from the time
+        // reached so far otherwise. Rounded up so the timer never fires early.
+        const f64 now_ticks = instance.m_updating ? static_cast<f64>(instance.m_current_tick - 1) : std::ceil(instance.m_time / tick_seconds);
+
+        Timer& timer = instance.m_timers[index];
+        timer.expires = static_cast<u64>(now_ticks) + to_ticks(delay_seconds);
+        timer.interval = interval_seconds > 0.0 ? to_ticks(interval_seconds) : 0;
+        timer.context = context;
+        timer.code = code;
+        timer.active = true;
+
+        instance.add(index);
+        instance.m_active_count++;
+
+        return TimerHandle{
+            .index = index,
+            .generation = timer.generation,
+        };
+    }
+
+    bool TimerSystem::cancel(TimerHandle handle) {
+        if (!is_active(handle))
+            return false;
+
+        TimerSystem& instance = get();
+        instance.unlink(handle.index);
+        instance.release(handle.index);
+        return true;
+    }
+
+    bool TimerSystem::is_active(TimerHandle handle) {
+        TimerSystem& instance = get();
+
+        if (handle.index >= instance.m_timers.length())
+            return false;
+
+        const Timer& timer = instance.m_timers[handle.index];
+        return timer.active && timer.generation == handle.generation;
+    }
+
+    void TimerSystem::update_impl(f64 delta_time) {
+        m_time += delta_time;
+        const u64 target_tick = static_cast<u64>(m_time / tick_seconds);
+
+        m_updating = true;
+        while (m_current_tick <= target_tick) {
+            const u32 index = m_current_tick & slot_mask;
+
+            // Level 0 wrapped, pull the next slot of every level above that also wrapped.
+            if (index == 0) {
+                for (u32 level = 1; level < level_count; level++) {
+                    const u32 slot = (m_current_tick >> (slot_bits * level)) & slot_mask;
+                    cascade(level, slot);
+                    if (slot != 0)
+                        break;
+                }
+            }
+
+            // Detach the expiring slot first, callbacks may schedule timers that land on it.
+            m_pending_head = m_slots[0][index];
+            m_slots[0][index] = none;
+            for (u32 i = m_pending_head; i != none; i = m_timers[i].next) {
+                m_timers[i].level = pending_level;
+            }
+
+            m_current_tick++;
+
+            while (m_pending_head != none) {
+                const u32 timer = m_pending_head;
+                unlink(timer);
+                fire(timer);
+            }
+        }
+        m_updating = false;
+    }
+
+    void TimerSystem::add(u32 index) {
+        Timer& timer = m_timers[index];
+
+        if (timer.expires < m_current_tick) {
+            link(index, 0, m_current_tick & slot_mask);
+            return;
+        }
+
+        const u64 delta = timer.expires - m_current_tick;
+        for (u32 level = 0; level < level_count; level++) {
+            if (delta < (u64{1} << (slot_bits * (level + 1)))) {
+                link(index, level, (timer.expires >> (slot_bits * level)) & slot_mask);
+                return;
+            }
+        }
+
+        // Past the wheel range, park it in the farthest slot and let it cascade from there.
+        const u32 last_level = level_count - 1;
+        link(index, last_level, ((m_current_tick >> (slot_bits * last_level)) + slot_mask) & slot_mask);
+    }
+
+    void TimerSystem::link(u32 index, u8 level, u8 slot) {
+        Timer& timer = m_timers[index];
+        u32& list = head(level, slot);
+
+        timer.level = level;
+        timer.slot = slot;
+        timer.prev = none;
+        timer.next = list;
+        if (list != none)
+            m_timers[list].prev = index;
+        list = index;
+    }
+
+    void TimerSystem::unlink(u32 index) {
+        Timer& timer = m_timers[index];
+
+        if (timer.prev != none) {
+            m_timers[timer.prev].next = timer.next;
+        } else {
+            head(timer.level, timer.slot) = timer.next;
+        }
+
+        if (timer.next != none)
+            m_timers[timer.next].prev = timer.prev;
+
+        timer.next = none;
+        timer.prev = none;
+    }
+
+    void TimerSystem::release(u32 index) {
+        Timer& timer = m_timers[index];
+        timer.active = false;
+        timer.generation++;
+        timer.next = m_free_head;
+        m_free_head = index;
+        m_active_count--;
+    }
+
+    void TimerSystem::cascade(u32 level, u32 slot) {
+        u32 index = m_slots[level][slot];
+        m_slots[level][slot] = none;
+
+        while (index != none) {
+            const u32 next = m_timers[index].next;
+            add(index);
+            index = next;
+        }
+    }
+
+    void TimerSystem::fire(u32 index) {
+        Timer& timer = m_timers[index];
+        const SystemEventCode code = timer.code;
+        const EventContext context = timer.context;
+
+        if (timer.interval > 0) {
+            timer.expires += timer.interval;
+            add(index);
+        } else {
+            release(index);
+        }
+
+        // The callback may schedule or cancel timers, nothing above is touched after it.
+        EventSystem::fire_event(code, this, context);
+    }
+
+    u64 TimerSystem::to_ticks(f64 seconds) {
+        const f64 ticks = std::ceil(seconds / tick_seconds);
+        const f64 max_ticks = static_cast<f64>(u64{1} << (slot_bits * level_count)) - 1;
+        if (ticks < 1.0)
+            return 1;
+        if (ticks > max_ticks) {
+            WarnLog("nk::TimerSystem Delay of {} seconds exceeds the wheel range, clamping.", seconds);
+            return static_cast<u64>(max_ticks);
+        }
+        return static_cast<u64>(ticks);
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "systems/event_system.h"
+
+namespace nk {
+    struct TimerHandle {
+        u32 index;
+        u32 generation;
+    };
+
+    // Hierarchical timer wheel. Four levels of 256 slots cover 2^32 ticks of
+    // one millisecond (about 49 days); scheduling and cancelling are O(1) and
+    // timers only move down a level when the level below wraps around, so
+    // firing stays O(1) amortized no matter how many timers are pending.
+    // Expired timers are dispatched through EventSystem::fire_event with the
+    // code and context they were scheduled with.
+    class TimerSystem {
+    public:
+        static constexpr f64 tick_seconds = 0.001;
+        static constexpr u32 slot_bits = 8;
+        static constexpr u32 slot_count = 1 << slot_bits;
+        static constexpr u32 slot_mask = slot_count - 1;
+        static constexpr u32 level_count = 4;
+
+        static constexpr TimerHandle invalid_handle = {
+            .index = std::numeric_limits<u32>::max(),
+            .generation = 0,
+        };
+
+        ~TimerSystem() = default;
+
+        static TimerSystem& init();
+        static void shutdown();
+
+        static TimerSystem& get() {
+            static TimerSystem instance;
+            return instance;
+        }
+
+        // Fires code after delay_seconds, then every interval_seconds when the
+        // interval is greater than zero.
+        static TimerHandle schedule(f64 delay_seconds, SystemEventCode code, const EventContext& context, f64 interval_seconds = 0.0);
+        static bool cancel(TimerHandle handle);
+        static bool is_active(TimerHandle handle);
+
+        static void update(f64 delta_time) { get().update_impl(delta_time); }
+
+        static u64 active_count() { return get().m_active_count; }
+
+    private:
+        struct Timer {
+            u64 expires;
+            u64 interval;
+            EventContext context;
+            SystemEventCode code;
+            u32 generation;
+            u32 next;
+            u32 prev;
+            u8 level;
+            u8 slot;
+            bool active;
+        };
+
+        static constexpr u32 none = std::numeric_limits<u32>::max();
+        static constexpr u8 pending_level = 0xFF;
+
+        TimerSystem() = default;
+
+        void update_impl(f64 delta_time);
+
+        void add(u32 index);
+        void link(u32 index, u8 level, u8 slot);
+        void unlink(u32 index);
+        void release(u32 index);
+        void cascade(u32 level, u32 slot);
+        void fire(u32 index);
+
+        u32& head(u8 level, u8 slot) { return level == pending_level ? m_pending_head : m_slots[level][slot]; }
+
+        static u64 to_ticks(f64 seconds);
+
+        mem::Allocator* m_allocator;
+        cl::dyarr<Timer> m_timers;
+        u32 m_free_head;
+        u32 m_pending_head;
+        u32 m_slots[level_count][slot_count];
+        u64 m_current_tick;
+        u64 m_active_count;
+        f64 m_time;
+        bool m_updating;
+    };
+}
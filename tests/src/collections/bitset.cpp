@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#undef NK_ACTIVE_MEMORY_SYSTEM
+#define NK_ACTIVE_MEMORY_SYSTEM FALSE
+
+#include "collections/bitset.h"
+#include "collections/dyn_bitset.h"
+#include "collections/bit_matrix.h"
+#include "memory/malloc_allocator.h"
+
+static_assert(nk::cl::bitset<256>{1, 200}.count() == 2);
+static_assert((~nk::cl::bitset<70>{}).count() == 70);
+static_assert(nk::cl::bitset<130>{129}.find_first() == 129);
+
+TEST(Bitset, BitsetOperations) {
+    nk::cl::bitset<300> a{0, 63, 64, 255, 299};
+    nk::cl::bitset<300> b{63, 100, 299};
+
+    EXPECT_EQ(a.count(), 5);
+    EXPECT_TRUE(a[64]);
+    EXPECT_FALSE(a[65]);
+
+    EXPECT_EQ((a & b).count(), 2);
+    EXPECT_EQ((a | b).count(), 6);
+    EXPECT_EQ((a ^ b).count(), 4);
+
+    nk::cl::bitset<300> c = a;
+    c.and_not(b);
+    EXPECT_EQ(c, (nk::cl::bitset<300>{0, 64, 255}));
+
+    nk::u64 expected[] = {0, 63, 64, 255, 299};
+    nk::u64 visited = 0;
+    a.for_each_set([&](nk::u64 bit) { EXPECT_EQ(bit, expected[visited++]); });
+    EXPECT_EQ(visited, 5);
+
+    EXPECT_EQ(a.find_next(65), 255);
+    EXPECT_EQ(a.find_next(300), 300);
+
+    c.set_all();
+    EXPECT_TRUE(c.all());
+    c.reset_all();
+    EXPECT_TRUE(c.none());
+}
+
+TEST(Bitset, DynBitsetAndMatrix) {
+    nk::mem::MallocAllocator allocator;
+
+    nk::cl::dyn_bitset dirty;
+    dirty.dyn_bitset_init(&allocator, 10);
+    dirty.set_all();
+    EXPECT_EQ(dirty.count(), 10);
+
+    dirty.dyn_bitset_resize(1000);
+    EXPECT_EQ(dirty.count(), 10);
+    EXPECT_EQ(dirty.find_next(10), 1000);
+
+    dirty.dyn_bitset_resize(5);
+    EXPECT_EQ(dirty.count(), 5);
+    dirty.dyn_bitset_resize(40);
+    EXPECT_EQ(dirty.count(), 5);
+
+    nk::cl::bit_matrix depends;
+    depends.bit_matrix_init(&allocator, 40, 40);
+    depends.set(1, 20);
+    depends.set(1, 21);
+    depends.set_symmetric(3, 39);
+    EXPECT_TRUE(depends.test(39, 3));
+    EXPECT_EQ(depends.count_row(1), 2);
+    EXPECT_EQ(depends.row_words() % nk::cl::bit_matrix::row_alignment_words, 0);
+
+    nk::cl::dyn_bitset touched;
+    touched.dyn_bitset_init(&allocator, 40);
+    depends.or_selected_rows(dirty, touched);
+    EXPECT_EQ(touched.count(), 3);
+    EXPECT_TRUE(touched[20] && touched[21] && touched[39]);
+
+    touched.and_not(dirty);
+    EXPECT_EQ(touched.count(), 3);
+
+    depends.bit_matrix_shutdown();
+    touched.dyn_bitset_shutdown();
+    dirty.dyn_bitset_shutdown();
+}
@@ -45,3 +45,44 @@ TEST(Arr, DyarrInit) {
 
     array.dyarr_shutdown();
 }
+
+TEST(Arr, DyarrBulkOperations) {
+    auto array = nk::cl::dyarr<nk::u32>();
+
+    nk::mem::MallocAllocator allocator;
+    array.dyarr_init(&allocator, 2);
+
+    const nk::u32 values[] = {0, 1, 2, 3, 4, 5};
+    array.dyarr_push_range(values, 6);
+    EXPECT_EQ(array.length(), 6);
+
+    const nk::u32 inserted[] = {10, 11};
+    array.dyarr_insert_range(2, inserted, 2);
+    EXPECT_EQ(array.length(), 8);
+    EXPECT_EQ(array[1], 1);
+    EXPECT_EQ(array[2], 10);
+    EXPECT_EQ(array[3], 11);
+    EXPECT_EQ(array[4], 2);
+    EXPECT_EQ(array[7], 5);
+
+    nk::u32* tail = array.dyarr_append_uninitialized(2);
+    tail[0] = 20;
+    tail[1] = 21;
+    EXPECT_EQ(array.length(), 10);
+    EXPECT_EQ(array[9], 21);
+
+    EXPECT_EQ(array.dyarr_swap_remove(0).value(), 0);
+    EXPECT_EQ(array[0], 21);
+    EXPECT_EQ(array.length(), 9);
+
+    const nk::u64 removed = array.dyarr_erase_if([](nk::u32 value) { return value >= 10 && value != 21; });
+    EXPECT_EQ(removed, 3);
+    EXPECT_EQ(array.length(), 6);
+
+    const nk::u32 expected[] = {21, 1, 2, 3, 4, 5};
+    for (nk::u64 i = 0; i < array.length(); i++) {
+        EXPECT_EQ(array[i], expected[i]);
+    }
+
+    array.dyarr_shutdown();
+}
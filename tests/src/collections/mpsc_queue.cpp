@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#undef NK_ACTIVE_MEMORY_SYSTEM
+#define NK_ACTIVE_MEMORY_SYSTEM FALSE
+
+#include "collections/mpsc_queue.h"
+
+TEST(MpscQueue, MpscQueuePushPop) {
+    nk::cl::mpsc_queue<nk::u32, 4> queue;
+
+    for (nk::u32 i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.mpsc_queue_push(i));
+    }
+    EXPECT_FALSE(queue.mpsc_queue_push(4));
+    EXPECT_EQ(queue.approximate_length(), 4);
+
+    nk::u32 value;
+    for (nk::u32 lap = 0; lap < 3; lap++) {
+        EXPECT_TRUE(queue.mpsc_queue_pop(value));
+        EXPECT_TRUE(queue.mpsc_queue_push(value));
+    }
+    EXPECT_TRUE(queue.mpsc_queue_pop(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_EQ(queue.approximate_length(), 3);
+}
+
+TEST(MpscQueue, MpscQueueManyProducers) {
+    static nk::cl::mpsc_queue<nk::u64, 1024> queue;
+    constexpr nk::u64 producers = 4;
+    constexpr nk::u64 per_producer = 50'000;
+
+    std::thread threads[producers];
+    for (nk::u64 t = 0; t < producers; t++) {
+        threads[t] = std::thread([t] {
+            for (nk::u64 i = 0; i < per_producer; i++) {
+                while (!queue.mpsc_queue_push((t << 32) | i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Each producer's values must come out in the order it pushed them.
+    nk::u64 next[producers] = {};
+    nk::u64 received = 0;
+    nk::u64 value;
+    while (received < producers * per_producer) {
+        if (!queue.mpsc_queue_pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        const nk::u64 producer = value >> 32;
+        ASSERT_EQ(value & 0xFFFFFFFF, next[producer]);
+        next[producer]++;
+        received++;
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_FALSE(queue.mpsc_queue_pop(value));
+}
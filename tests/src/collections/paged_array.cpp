@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+
+#undef NK_ACTIVE_MEMORY_SYSTEM
+#define NK_ACTIVE_MEMORY_SYSTEM FALSE
+
+#include "collections/paged_array.h"
+#include "memory/malloc_allocator.h"
+
+TEST(PagedArray, PagedArrayStableReferences) {
+    nk::cl::paged_array<nk::u64, 16> array;
+
+    nk::mem::MallocAllocator allocator;
+    array.paged_array_init(&allocator, 0);
+
+    nk::u64 first_value = 0;
+    nk::u64* first = &array.paged_array_push(first_value);
+
+    for (nk::u64 i = 1; i < 1000; i++) {
+        array.paged_array_push_copy(i);
+    }
+
+    EXPECT_EQ(first, &array[0]);
+    EXPECT_EQ(array.length(), 1000);
+    EXPECT_EQ(array.page_count(), 1000 / 16 + 1);
+    EXPECT_EQ(array.page_length(array.page_count() - 1), 1000 % 16);
+
+    nk::u64 expected = 0;
+    for (nk::u64 value : array) {
+        EXPECT_EQ(value, expected);
+        expected++;
+    }
+
+    EXPECT_EQ(array.paged_array_pop().value(), 999);
+    EXPECT_EQ(array.paged_array_last(), 998);
+
+    array.paged_array_reset();
+    EXPECT_TRUE(array.empty());
+    EXPECT_EQ(array.capacity(), array.page_count() * 16);
+    EXPECT_EQ(array.page_length(array.page_count() - 1), 0);
+
+    array.paged_array_resize(40);
+    EXPECT_EQ(array[39], 0);
+
+    array.paged_array_shutdown();
+}
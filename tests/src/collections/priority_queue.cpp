@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#undef NK_ACTIVE_MEMORY_SYSTEM
+#define NK_ACTIVE_MEMORY_SYSTEM FALSE
+
+#include <random>
+
+#include "collections/priority_queue.h"
+#include "memory/malloc_allocator.h"
+
+TEST(PriorityQueue, PriorityQueuePopOrder) {
+    nk::cl::priority_queue<nk::u32> queue;
+
+    nk::mem::MallocAllocator allocator;
+    queue.priority_queue_init(&allocator, 4);
+
+    std::mt19937 random(3);
+    for (nk::u32 i = 0; i < 500; i++) {
+        queue.priority_queue_push(random() % 1000);
+    }
+    EXPECT_EQ(queue.length(), 500);
+
+    nk::u32 previous = 0;
+    while (auto value = queue.priority_queue_pop()) {
+        EXPECT_GE(*value, previous);
+        previous = *value;
+    }
+    EXPECT_TRUE(queue.empty());
+
+    queue.priority_queue_shutdown();
+}
+
+TEST(PriorityQueue, PriorityQueueHandles) {
+    nk::cl::priority_queue<nk::f32, std::greater<nk::f32>> queue;
+
+    nk::mem::MallocAllocator allocator;
+    queue.priority_queue_init(&allocator, 4);
+
+    auto low = queue.priority_queue_push(1.0f);
+    auto mid = queue.priority_queue_push(5.0f);
+    auto high = queue.priority_queue_push(10.0f);
+    EXPECT_EQ(queue.top_handle(), high);
+
+    EXPECT_TRUE(queue.priority_queue_update(low, 20.0f));
+    EXPECT_EQ(queue.top_handle(), low);
+
+    EXPECT_TRUE(queue.priority_queue_update(low, 0.5f));
+    EXPECT_EQ(queue.top_handle(), high);
+
+    EXPECT_FLOAT_EQ(*queue.priority_queue_remove(high), 10.0f);
+    EXPECT_FALSE(queue.contains(high));
+    EXPECT_FALSE(queue.priority_queue_remove(high).has_value());
+    EXPECT_EQ(queue.top_handle(), mid);
+
+    auto reused = queue.priority_queue_push(7.0f);
+    EXPECT_EQ(reused, high);
+    EXPECT_FLOAT_EQ(queue.get(reused), 7.0f);
+
+    EXPECT_FLOAT_EQ(*queue.priority_queue_pop(), 7.0f);
+    EXPECT_FLOAT_EQ(*queue.priority_queue_pop(), 5.0f);
+    EXPECT_FLOAT_EQ(*queue.priority_queue_pop(), 0.5f);
+
+    queue.priority_queue_shutdown();
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#undef NK_ACTIVE_MEMORY_SYSTEM
+#define NK_ACTIVE_MEMORY_SYSTEM FALSE
+
+#include "collections/soa_dyarr.h"
+#include "memory/malloc_allocator.h"
+
+struct SoaPosition {
+    nk::f32 x;
+    nk::f32 y;
+    nk::f32 z;
+};
+
+TEST(SoaDyarr, SoaDyarrPushAndColumns) {
+    nk::cl::soa_dyarr<SoaPosition, nk::u32, nk::f32> array;
+
+    nk::mem::MallocAllocator allocator;
+    array.soa_dyarr_init(&allocator, 2);
+
+    for (nk::u32 i = 0; i < 10; i++) {
+        array.soa_dyarr_push(SoaPosition{.x = static_cast<nk::f32>(i), .y = 0, .z = 0}, i, i * 0.5f);
+    }
+
+    EXPECT_EQ(array.length(), 10);
+    EXPECT_GE(array.capacity(), 10);
+
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(array.column<0>()) % array.soa_alignment, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(array.column<1>()) % array.soa_alignment, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(array.column<2>()) % array.soa_alignment, 0);
+
+    for (nk::u32 i = 0; i < array.length(); i++) {
+        auto [position, id, weight] = array[i];
+        EXPECT_FLOAT_EQ(position.x, static_cast<nk::f32>(i));
+        EXPECT_EQ(id, i);
+        EXPECT_FLOAT_EQ(weight, i * 0.5f);
+    }
+
+    array.soa_dyarr_shutdown();
+}
+
+TEST(SoaDyarr, SoaDyarrRemoveAndZip) {
+    nk::cl::soa_dyarr<nk::u32, nk::f32> array;
+
+    nk::mem::MallocAllocator allocator;
+    array.soa_dyarr_init(&allocator, 4);
+
+    for (nk::u32 i = 0; i < 6; i++) {
+        array.soa_dyarr_push(i, static_cast<nk::f32>(i));
+    }
+
+    EXPECT_TRUE(array.soa_dyarr_remove(1));
+    EXPECT_EQ(array.get<0>(1), 2);
+
+    EXPECT_TRUE(array.soa_dyarr_swap_remove(0));
+    EXPECT_EQ(array.get<0>(0), 5);
+    EXPECT_FLOAT_EQ(array.get<1>(0), 5.0f);
+    EXPECT_EQ(array.length(), 4);
+
+    for (auto [id, value] : array.zip<0, 1>()) {
+        value = static_cast<nk::f32>(id * 2);
+    }
+
+    array.for_each<1>([](nk::f32& value) { value += 1.0f; });
+
+    for (nk::u32 i = 0; i < array.length(); i++) {
+        EXPECT_FLOAT_EQ(array.get<1>(i), array.get<0>(i) * 2.0f + 1.0f);
+    }
+
+    array.soa_dyarr_resize(8);
+    EXPECT_EQ(array.get<0>(7), 0);
+
+    array.soa_dyarr_shutdown();
+}
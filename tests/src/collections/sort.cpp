@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#undef NK_ACTIVE_MEMORY_SYSTEM
+#define NK_ACTIVE_MEMORY_SYSTEM FALSE
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "collections/sort.h"
+#include "memory/malloc_allocator.h"
+
+template <typename K>
+static std::vector<K> random_keys(nk::u64 count, nk::u32 seed) {
+    std::mt19937_64 random(seed);
+    std::vector<K> keys(count);
+    for (auto& key : keys) {
+        if constexpr (std::is_floating_point_v<K>) {
+            key = std::uniform_real_distribution<K>(-1000, 1000)(random);
+        } else {
+            key = static_cast<K>(random());
+        }
+    }
+    return keys;
+}
+
+template <typename K>
+static void expect_radix_sorted(nk::u64 count) {
+    nk::mem::MallocAllocator allocator;
+
+    auto keys = random_keys<K>(count, 7);
+    auto expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    nk::cl::radix_sort(&allocator, keys.data(), keys.size());
+    EXPECT_EQ(keys, expected);
+}
+
+TEST(Sort, RadixSortKeys) {
+    expect_radix_sorted<nk::u32>(1000);
+    expect_radix_sorted<nk::i32>(1000);
+    expect_radix_sorted<nk::u64>(1000);
+    expect_radix_sorted<nk::i64>(1000);
+    expect_radix_sorted<nk::f32>(1000);
+    expect_radix_sorted<nk::f64>(1000);
+
+    nk::f32 floats[] = {3.5f, -0.0f, -2.0f, 0.0f, -100.25f, 1e-8f, -1e-8f};
+    nk::f32 scratch[std::size(floats)];
+    nk::cl::radix_sort_scratch(floats, std::size(floats), scratch);
+    EXPECT_TRUE(std::is_sorted(std::begin(floats), std::end(floats)));
+    EXPECT_FLOAT_EQ(floats[0], -100.25f);
+}
+
+TEST(Sort, RadixSortPairsIsStable) {
+    nk::mem::MallocAllocator allocator;
+
+    nk::u32 keys[] = {3, 1, 3, 0, 1, 3};
+    nk::u32 values[] = {0, 1, 2, 3, 4, 5};
+    nk::cl::radix_sort_pairs(&allocator, keys, values, std::size(keys));
+
+    const nk::u32 expected_keys[] = {0, 1, 1, 3, 3, 3};
+    const nk::u32 expected_values[] = {3, 1, 4, 0, 2, 5};
+    for (nk::u64 i = 0; i < std::size(keys); i++) {
+        EXPECT_EQ(keys[i], expected_keys[i]);
+        EXPECT_EQ(values[i], expected_values[i]);
+    }
+}
+
+TEST(Sort, RadixSortParallel) {
+    nk::mem::MallocAllocator allocator;
+
+    const nk::u64 count = nk::cl::radix::parallel_threshold * 4 + 3;
+    auto keys = random_keys<nk::f32>(count, 11);
+    std::vector<nk::u32> values(count);
+    for (nk::u32 i = 0; i < count; i++) {
+        values[i] = i;
+    }
+    const auto original = keys;
+
+    nk::cl::radix_sort_pairs_parallel(&allocator, keys.data(), values.data(), count, 4);
+
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+    for (nk::u64 i = 0; i < count; i++) {
+        EXPECT_EQ(original[values[i]], keys[i]);
+    }
+
+    auto integers = random_keys<nk::u64>(count, 13);
+    auto expected = integers;
+    std::sort(expected.begin(), expected.end());
+    nk::cl::radix_sort_parallel(&allocator, integers.data(), count, 4);
+    EXPECT_EQ(integers, expected);
+}
+
+// Run with --gtest_also_run_disabled_tests to compare against std::sort.
+TEST(Sort, DISABLED_RadixSortBenchmark) {
+    nk::mem::MallocAllocator allocator;
+
+    for (nk::u64 count : {1'000ull, 100'000ull, 10'000'000ull}) {
+        const auto keys = random_keys<nk::f32>(count, 17);
+
+        auto measure = [&](auto&& sort) {
+            auto copy = keys;
+            const auto start = std::chrono::steady_clock::now();
+            sort(copy);
+            const auto end = std::chrono::steady_clock::now();
+            EXPECT_TRUE(std::is_sorted(copy.begin(), copy.end()));
+            return std::chrono::duration<nk::f64, std::micro>(end - start).count();
+        };
+
+        const nk::f64 std_time = measure([](auto& v) { std::sort(v.begin(), v.end()); });
+        const nk::f64 radix_time = measure([&](auto& v) { nk::cl::radix_sort(&allocator, v.data(), v.size()); });
+        const nk::f64 parallel_time =
+            measure([&](auto& v) { nk::cl::radix_sort_parallel(&allocator, v.data(), v.size()); });
+
+        std::printf("%10llu keys: std::sort %10.1fus | radix_sort %10.1fus | radix_sort_parallel %10.1fus\n",
+                    static_cast<unsigned long long>(count), std_time, radix_time, parallel_time);
+    }
+}
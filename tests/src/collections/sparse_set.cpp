@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#undef NK_ACTIVE_MEMORY_SYSTEM
+#define NK_ACTIVE_MEMORY_SYSTEM FALSE
+
+#include "collections/sparse_set.h"
+#include "memory/malloc_allocator.h"
+
+TEST(SparseSet, SparseSetInsertRemove) {
+    nk::cl::sparse_set<nk::u32, void, 64> set;
+
+    nk::mem::MallocAllocator allocator;
+    set.sparse_set_init(&allocator, 2);
+
+    EXPECT_TRUE(set.sparse_set_insert(5));
+    EXPECT_TRUE(set.sparse_set_insert(1000));
+    EXPECT_TRUE(set.sparse_set_insert(70));
+    EXPECT_FALSE(set.sparse_set_insert(5));
+    EXPECT_EQ(set.length(), 3);
+
+    EXPECT_TRUE(set.contains(1000));
+    EXPECT_FALSE(set.contains(6));
+    EXPECT_FALSE(set.contains(100000));
+
+    EXPECT_TRUE(set.sparse_set_remove(5));
+    EXPECT_FALSE(set.sparse_set_remove(5));
+    EXPECT_FALSE(set.contains(5));
+    EXPECT_EQ(set.length(), 2);
+
+    nk::u64 sum = 0;
+    for (nk::u32 id : set) {
+        sum += id;
+    }
+    EXPECT_EQ(sum, 1070);
+
+    set.sparse_set_reset();
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains(70));
+    EXPECT_TRUE(set.sparse_set_insert(70));
+
+    set.sparse_set_shutdown();
+}
+
+TEST(SparseSet, SparseSetValues) {
+    nk::cl::sparse_set<nk::u32, nk::f32> set;
+
+    nk::mem::MallocAllocator allocator;
+    set.sparse_set_init(&allocator, 0);
+
+    for (nk::u32 i = 0; i < 100; i++) {
+        set.sparse_set_insert(i * 3, static_cast<nk::f32>(i));
+    }
+    EXPECT_EQ(set.length(), 100);
+
+    set.sparse_set_insert(3, 42.0f);
+    EXPECT_FLOAT_EQ(*set.get(3), 42.0f);
+    EXPECT_EQ(set.get(4), nullptr);
+
+    for (nk::u32 i = 0; i < 100; i += 2) {
+        EXPECT_TRUE(set.sparse_set_remove(i * 3));
+    }
+    EXPECT_EQ(set.length(), 50);
+
+    for (nk::u64 i = 0; i < set.length(); i++) {
+        const nk::u32 id = set.data()[i];
+        EXPECT_EQ(set.index_of(id), i);
+        if (id != 3) {
+            EXPECT_FLOAT_EQ(set.values()[i], static_cast<nk::f32>(id / 3));
+        }
+    }
+
+    set.sparse_set_shutdown();
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#undef NK_ACTIVE_MEMORY_SYSTEM
+#define NK_ACTIVE_MEMORY_SYSTEM FALSE
+
+#include "collections/spsc_ring.h"
+
+TEST(SpscRing, SpscRingReserveCommit) {
+    static nk::cl::spsc_ring<128> ring;
+    EXPECT_TRUE(ring.empty());
+
+    // Reservations are trimmed on commit and nothing shows before it.
+    nk::u8* data = ring.spsc_ring_reserve(40);
+    ASSERT_NE(data, nullptr);
+    std::memset(data, 1, 10);
+    nk::u64 size;
+    EXPECT_EQ(ring.spsc_ring_peek(size), nullptr);
+    ring.spsc_ring_commit(10);
+
+    data = ring.spsc_ring_reserve(50);
+    ASSERT_NE(data, nullptr);
+    std::memset(data, 2, 50);
+    ring.spsc_ring_commit(50);
+
+    // 24 + 64 bytes used, another 50 does not fit.
+    EXPECT_EQ(ring.spsc_ring_reserve(50), nullptr);
+    EXPECT_EQ(ring.spsc_ring_reserve(ring.max_block_size() + 1), nullptr);
+
+    const nk::u8* block = ring.spsc_ring_peek(size);
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(size, 10);
+    EXPECT_EQ(block[9], 1);
+    ring.spsc_ring_release();
+
+    data = ring.spsc_ring_reserve(16);
+    ASSERT_NE(data, nullptr);
+    std::memset(data, 3, 16);
+    ring.spsc_ring_commit(16);
+
+    // 16 bytes are left before the end, the block wraps to the start once
+    // the consumer frees it.
+    EXPECT_EQ(ring.spsc_ring_reserve(24), nullptr);
+
+    block = ring.spsc_ring_peek(size);
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(size, 50);
+    EXPECT_EQ(block[49], 2);
+    ring.spsc_ring_release();
+
+    data = ring.spsc_ring_reserve(24);
+    ASSERT_NE(data, nullptr);
+    std::memset(data, 4, 24);
+    ring.spsc_ring_commit(24);
+
+    block = ring.spsc_ring_peek(size);
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(size, 16);
+    EXPECT_EQ(block[0], 3);
+    ring.spsc_ring_release();
+
+    block = ring.spsc_ring_peek(size);
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(size, 24);
+    EXPECT_EQ(block[23], 4);
+    ring.spsc_ring_release();
+
+    EXPECT_EQ(ring.spsc_ring_peek(size), nullptr);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRing, SpscRingReserveLargeOnEmpty) {
+    static nk::cl::spsc_ring<128> ring;
+    nk::u64 size;
+
+    // Moves the empty ring to offset 40.
+    nk::u8* data = ring.spsc_ring_reserve(32);
+    ASSERT_NE(data, nullptr);
+    ring.spsc_ring_commit(32);
+    ASSERT_NE(ring.spsc_ring_peek(size), nullptr);
+    ring.spsc_ring_release();
+    EXPECT_TRUE(ring.empty());
+
+    // Does not fit before the end and is larger than the offset, it still
+    // takes the front of the empty ring.
+    data = ring.spsc_ring_reserve(ring.max_block_size());
+    ASSERT_NE(data, nullptr);
+    std::memset(data, 5, ring.max_block_size());
+    ring.spsc_ring_commit(ring.max_block_size());
+
+    EXPECT_EQ(ring.spsc_ring_reserve(8), nullptr);
+
+    const nk::u8* block = ring.spsc_ring_peek(size);
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(size, ring.max_block_size());
+    EXPECT_EQ(block[0], 5);
+    EXPECT_EQ(block[size - 1], 5);
+    ring.spsc_ring_release();
+    EXPECT_TRUE(ring.empty());
+
+    data = ring.spsc_ring_reserve(8);
+    ASSERT_NE(data, nullptr);
+    std::memset(data, 6, 8);
+    ring.spsc_ring_commit(8);
+
+    block = ring.spsc_ring_peek(size);
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(size, 8);
+    EXPECT_EQ(block[7], 6);
+    ring.spsc_ring_release();
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRing, SpscRingProducerConsumer) {
+    static nk::cl::spsc_ring<1024> ring;
+    constexpr nk::u64 count = 200'000;
+
+    std::thread producer([] {
+        for (nk::u64 i = 0; i < count; i++) {
+            // Sizes from 8 to 71 bytes so blocks wrap at every offset.
+            const nk::u64 size = 8 + (i % 64);
+            nk::u8* data;
+            while ((data = ring.spsc_ring_reserve(size)) == nullptr) {
+                std::this_thread::yield();
+            }
+            std::memcpy(data, &i, sizeof(i));
+            ring.spsc_ring_commit(size);
+        }
+    });
+
+    nk::u64 expected = 0;
+    while (expected < count) {
+        nk::u64 size;
+        const nk::u8* data = ring.spsc_ring_peek(size);
+        if (data == nullptr) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        nk::u64 value;
+        std::memcpy(&value, data, sizeof(value));
+        ASSERT_EQ(value, expected);
+        ASSERT_EQ(size, 8 + (expected % 64));
+        ring.spsc_ring_release();
+        expected++;
+    }
+
+    producer.join();
+    EXPECT_TRUE(ring.empty());
+}
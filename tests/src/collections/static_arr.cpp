@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#undef NK_ACTIVE_MEMORY_SYSTEM
+#define NK_ACTIVE_MEMORY_SYSTEM FALSE
+
+#include "collections/static_arr.h"
+#include "collections/view.h"
+
+static_assert(nk::IArr<nk::cl::static_arr<nk::u32, 4>, nk::u32>);
+static_assert(std::ranges::contiguous_range<nk::cl::inplace_vector<nk::f32, 8>>);
+
+static constexpr nk::u64 static_arr_sum() {
+    nk::cl::static_arr<nk::u64, 8> array{1, 2, 3};
+    array.static_arr_push_copy(4);
+    array.static_arr_swap_remove(0);
+
+    nk::u64 sum = 0;
+    for (nk::u64 value : array) {
+        sum += value;
+    }
+    return sum + array.length();
+}
+static_assert(static_arr_sum() == 12);
+
+TEST(StaticArr, StaticArrPushPop) {
+    nk::cl::static_arr<std::string, 4> array;
+
+    std::string hello = "hello";
+    array.static_arr_push(hello);
+    array.static_arr_push_copy("world");
+    array.static_arr_push_copy("!");
+    EXPECT_EQ(array.length(), 3);
+    EXPECT_EQ(array.first(), "hello");
+    EXPECT_EQ(array.last(), "!");
+
+    auto removed = array.static_arr_remove(0);
+    EXPECT_EQ(*removed, "hello");
+    EXPECT_EQ(array[0], "world");
+
+    auto popped = array.static_arr_pop();
+    EXPECT_EQ(*popped, "!");
+    EXPECT_EQ(array.length(), 1);
+    EXPECT_FALSE(array.static_arr_remove(3).has_value());
+
+    array.static_arr_resize(4);
+    EXPECT_TRUE(array.full());
+    EXPECT_TRUE(array[3].empty());
+
+    nk::cl::view<std::string> view = array;
+    EXPECT_EQ(view.length(), 4);
+
+    array.static_arr_reset();
+    EXPECT_TRUE(array.empty());
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#undef NK_ACTIVE_MEMORY_SYSTEM
+#define NK_ACTIVE_MEMORY_SYSTEM FALSE
+
+#include <algorithm>
+#include <numeric>
+#include <ranges>
+
+#include "collections/arr.h"
+#include "collections/dyarr.h"
+#include "collections/view.h"
+#include "memory/malloc_allocator.h"
+
+static_assert(std::ranges::contiguous_range<nk::cl::arr<nk::u32>>);
+static_assert(std::ranges::contiguous_range<nk::cl::dyarr<nk::u32>>);
+static_assert(std::ranges::contiguous_range<nk::cl::view<nk::u32>>);
+
+TEST(View, ViewStandardAlgorithms) {
+    auto array = nk::cl::dyarr<nk::u32>();
+
+    nk::mem::MallocAllocator allocator;
+    array.dyarr_init(&allocator, 8);
+
+    const nk::u32 values[] = {5, 3, 7, 1, 4, 6, 2, 0};
+    array.dyarr_push_range(values, 8);
+
+    std::sort(array.begin(), array.end());
+    EXPECT_TRUE(std::ranges::is_sorted(array));
+
+    std::span<nk::u32> span = array;
+    EXPECT_EQ(span.size(), 8);
+    EXPECT_EQ(span[7], 7);
+
+    nk::cl::view<nk::u32> slice = nk::cl::view(array).subview(2, 4);
+    EXPECT_EQ(slice.length(), 4);
+    EXPECT_EQ(slice[0], 2);
+    EXPECT_EQ(std::accumulate(slice.begin(), slice.end(), 0u), 2u + 3u + 4u + 5u);
+
+    for (nk::u32& value : slice) {
+        value *= 10;
+    }
+    EXPECT_EQ(array[3], 30);
+
+    nk::cl::view<const nk::u32> read_only = slice.last(2);
+    EXPECT_EQ(read_only[0], 40);
+
+    nk::cl::view<const nk::u32> from_values = values;
+    EXPECT_EQ(std::ranges::max(from_values), 7);
+
+    array.dyarr_shutdown();
+}
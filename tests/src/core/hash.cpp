@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include "core/hash.h"
+
+static_assert(nk::hash::string("") == 0x93228a4de0eec5a2ull);
+static_assert(nk::hash::string("a", 1) == 0xc5bac3db178713c4ull);
+static_assert(nk::hash::string("abc", 2) == 0xa97f2f7b1d9b3314ull);
+static_assert(nk::hash::string("jump") != nk::hash::string("Jump"));
+static_assert(nk::hash::combine(1, 2) != nk::hash::combine(2, 1));
+
+static std::vector<nk::u8> random_bytes(nk::u64 count, nk::u32 seed) {
+    std::mt19937 random(seed);
+    std::vector<nk::u8> bytes(count);
+    for (nk::u8& byte : bytes) {
+        byte = static_cast<nk::u8>(random());
+    }
+    return bytes;
+}
+
+TEST(Hash, Hash64KnownValues) {
+    const std::string_view digits =
+        "12345678901234567890123456789012345678901234567890123456789012345678901234567890";
+    EXPECT_EQ(nk::hash::string(digits, 6), 0x6cc5eab49a92d617ull);
+    EXPECT_EQ(nk::hash::hash64(digits.data(), digits.length(), 6), 0x6cc5eab49a92d617ull);
+
+    // Exact multiples of the stripe keep their last stripe for the tail.
+    const std::string_view stripes =
+        "123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456";
+    EXPECT_EQ(nk::hash::hash64(stripes.data(), 48), 0x5415d932c2a5c457ull);
+    EXPECT_EQ(nk::hash::hash64(stripes.data(), 96), 0x38ed13b4e05d232eull);
+    EXPECT_EQ(nk::hash::string(stripes), 0x38ed13b4e05d232eull);
+
+    constexpr nk::u64 compile_time = nk::hash::string("nk::hash constexpr string longer than a stripe of 48 bytes");
+    const std::string runtime = "nk::hash constexpr string longer than a stripe of 48 bytes";
+    EXPECT_EQ(nk::hash::hash64(runtime.data(), runtime.length()), compile_time);
+}
+
+TEST(Hash, HasherMatchesHash64) {
+    const auto bytes = random_bytes(300, 3);
+
+    for (nk::u64 length = 0; length <= bytes.size(); length++) {
+        const nk::u64 expected = nk::hash::hash64(bytes.data(), length, 42);
+
+        for (nk::u64 piece : {1ull, 7ull, 16ull, 47ull, 48ull, 49ull, 100ull}) {
+            nk::hash::Hasher hasher(42);
+            for (nk::u64 offset = 0; offset < length; offset += piece) {
+                hasher.update(bytes.data() + offset, std::min(piece, length - offset));
+            }
+            ASSERT_EQ(hasher.finish(), expected) << "length " << length << " piece " << piece;
+            EXPECT_EQ(hasher.length(), length);
+        }
+    }
+
+    nk::hash::Hasher hasher;
+    hasher.update_string("hello ");
+    hasher.update_value(nk::u32{7});
+    hasher.reset();
+    hasher.update_string("hello world");
+    EXPECT_EQ(hasher.finish(), nk::hash::string("hello world"));
+}
+
+TEST(Hash, Hash128) {
+    const auto bytes = random_bytes(1024, 5);
+
+    const nk::hash::Hash128 hash = nk::hash::hash128(bytes.data(), bytes.size());
+    EXPECT_EQ(hash.low, nk::hash::hash64(bytes.data(), bytes.size()));
+    EXPECT_NE(hash.low, hash.high);
+    EXPECT_EQ(hash, nk::hash::hash128(bytes.data(), bytes.size()));
+    EXPECT_NE(hash, nk::hash::hash128(bytes.data(), bytes.size() - 1));
+    EXPECT_NE(hash, nk::hash::hash128(bytes.data(), bytes.size(), 1));
+
+    constexpr nk::hash::Hash128 text = nk::hash::string128("pipeline cache");
+    EXPECT_EQ(text, nk::hash::hash128("pipeline cache", 14));
+}
+
+TEST(Hash, NoCollisionsOnSequentialKeys) {
+    std::unordered_set<nk::u64> seen;
+    for (nk::u64 i = 0; i < 100'000; i++) {
+        seen.insert(nk::hash::hash_value(i));
+        seen.insert(nk::hash::combine(0xABCDEF, i));
+    }
+    EXPECT_EQ(seen.size(), 200'000);
+}
+
+TEST(Hash, DISABLED_HashBenchmark) {
+    for (nk::u64 size : {8ull, 64ull, 1'024ull, 1'048'576ull}) {
+        const auto bytes = random_bytes(size, 11);
+        const std::string_view text(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        const nk::u64 iterations = MaxValue(1ull, 256'000'000ull / (size * 64));
+
+        auto measure = [&](auto&& hash) {
+            nk::u64 sink = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (nk::u64 i = 0; i < iterations; i++) {
+                sink += hash();
+            }
+            const auto end = std::chrono::steady_clock::now();
+            EXPECT_NE(sink, 0);
+            const nk::f64 seconds = std::chrono::duration<nk::f64>(end - start).count();
+            return static_cast<nk::f64>(size * iterations) / seconds / 1e9;
+        };
+
+        const nk::f64 std_speed = measure([&] { return std::hash<std::string_view>{}(text); });
+        const nk::f64 hash64_speed = measure([&] { return nk::hash::hash64(bytes.data(), bytes.size()); });
+        const nk::f64 hash128_speed = measure([&] {
+            const nk::hash::Hash128 hash = nk::hash::hash128(bytes.data(), bytes.size());
+            return hash.low ^ hash.high;
+        });
+
+        std::printf("%10llu bytes: std::hash %6.2f GB/s | hash64 %6.2f GB/s | hash128 %6.2f GB/s\n",
+                    static_cast<unsigned long long>(size), std_speed, hash64_speed, hash128_speed);
+    }
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include "core/hash.h"
+#include "systems/event_channel.h"
+#include "systems/memory_system.h"
+
+struct ChannelTestAsset {
+    static constexpr nk::u64 channel_id = nk::hash::string("ChannelTestAsset");
+
+    nk::u32 id;
+    char path[200];
+};
+
+struct alignas(64) ChannelTestLarge {
+    static constexpr nk::u64 channel_id = nk::hash::string("ChannelTestLarge");
+
+    nk::u64 values[16 * 1024];
+};
+
+static nk::u32 channel_test_ids[16];
+static nk::u32 channel_test_length;
+
+static bool on_asset(const ChannelTestAsset& asset, void* listener) {
+    channel_test_ids[channel_test_length++] = asset.id;
+
+    // Posted while dispatching, it waits for the next dispatch.
+    if (asset.id == 2) {
+        ChannelTestAsset repost = {.id = 3};
+        std::strcpy(repost.path, "repost");
+        nk::EventChannel<ChannelTestAsset>::post(repost);
+    }
+    return false;
+}
+
+static bool on_asset_consume(const ChannelTestAsset& asset, void* listener) {
+    return asset.id == 1;
+}
+
+static nk::u64 channel_test_large_sum;
+
+static bool on_large(const ChannelTestLarge& large, void* listener) {
+    EXPECT_EQ(reinterpret_cast<nk::u64>(&large) % alignof(ChannelTestLarge), 0);
+    channel_test_large_sum += large.values[0] + large.values[16 * 1024 - 1];
+    return false;
+}
+
+TEST(EventChannel, EventChannelPostAndDispatch) {
+    NK_MEMORY_SYSTEM_INIT();
+    nk::EventSystem::init();
+
+    using AssetChannel = nk::EventChannel<ChannelTestAsset>;
+    const nk::EventHandle listener = AssetChannel::register_listener(nullptr, on_asset);
+    const nk::EventHandle consumer = AssetChannel::register_listener(nullptr, on_asset_consume, 10);
+
+    for (nk::u32 i = 0; i < 3; i++) {
+        const ChannelTestAsset& posted = AssetChannel::post(ChannelTestAsset{.id = i});
+        EXPECT_EQ(posted.id, i);
+    }
+    EXPECT_EQ(AssetChannel::queued_count(), 3);
+    EXPECT_EQ(channel_test_length, 0);
+
+    // The high priority listener consumes id 1 before the other one sees it.
+    nk::EventSystem::dispatch();
+    ASSERT_EQ(channel_test_length, 2);
+    EXPECT_EQ(channel_test_ids[0], 0);
+    EXPECT_EQ(channel_test_ids[1], 2);
+    EXPECT_EQ(AssetChannel::queued_count(), 1);
+
+    nk::EventSystem::dispatch();
+    ASSERT_EQ(channel_test_length, 3);
+    EXPECT_EQ(channel_test_ids[2], 3);
+    EXPECT_EQ(AssetChannel::queued_count(), 0);
+
+    EXPECT_TRUE(AssetChannel::fire(ChannelTestAsset{.id = 1}));
+    EXPECT_TRUE(AssetChannel::unregister_listener(consumer));
+    EXPECT_FALSE(AssetChannel::fire(ChannelTestAsset{.id = 1}));
+    EXPECT_EQ(channel_test_length, 4);
+
+    // Payloads larger than an arena block get a block of their own.
+    using LargeChannel = nk::EventChannel<ChannelTestLarge>;
+    const nk::EventHandle large = LargeChannel::register_listener(nullptr, on_large);
+    for (nk::u64 frame = 0; frame < 2; frame++) {
+        for (nk::u64 i = 0; i < 3; i++) {
+            ChannelTestLarge& payload = const_cast<ChannelTestLarge&>(LargeChannel::post());
+            payload.values[0] = i;
+            payload.values[16 * 1024 - 1] = 1;
+        }
+        nk::EventSystem::dispatch();
+    }
+    EXPECT_EQ(channel_test_large_sum, 2 * (0 + 1 + 2 + 3));
+
+    LargeChannel::unregister_listener(large);
+    AssetChannel::unregister_listener(listener);
+    nk::EventSystem::shutdown();
+    NK_MEMORY_SYSTEM_SHUTDOWN();
+}
+
+struct ChannelTestBench {
+    static constexpr nk::u64 channel_id = nk::hash::string("ChannelTestBench");
+
+    nk::u32 value;
+};
+
+static nk::u64 channel_test_bench_sum;
+
+static bool on_bench_payload(const ChannelTestBench& payload, void* listener) {
+    channel_test_bench_sum += payload.value;
+    return false;
+}
+
+static bool on_bench_event(nk::SystemEventCode code, void* sender, void* listener, nk::EventContext context) {
+    channel_test_bench_sum += context.data.u32[0];
+    return false;
+}
+
+// Run with --gtest_also_run_disabled_tests to compare against the EventContext path.
+TEST(EventChannel, DISABLED_EventChannelBenchmark) {
+    NK_MEMORY_SYSTEM_INIT();
+    nk::EventSystem::init();
+
+    constexpr nk::SystemEventCode code = static_cast<nk::SystemEventCode>(0x43);
+    const nk::EventHandle event = nk::EventSystem::register_event(code, nullptr, on_bench_event);
+    const nk::EventHandle channel = nk::EventChannel<ChannelTestBench>::register_listener(nullptr, on_bench_payload);
+
+    for (nk::u64 batch : {16ull, 256ull, 1'000ull}) {
+        const nk::u64 frames = 10'000'000ull / batch;
+
+        auto measure = [&](auto&& frame) {
+            channel_test_bench_sum = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (nk::u64 i = 0; i < frames; i++) {
+                frame();
+            }
+            const auto end = std::chrono::steady_clock::now();
+            EXPECT_EQ(channel_test_bench_sum, frames * batch * (batch - 1) / 2);
+            return std::chrono::duration<nk::f64, std::nano>(end - start).count() / static_cast<nk::f64>(frames * batch);
+        };
+
+        const nk::f64 event_time = measure([&] {
+            nk::EventContext context = {};
+            for (nk::u32 i = 0; i < batch; i++) {
+                context.data.u32[0] = i;
+                nk::EventSystem::post_event(code, nullptr, context);
+            }
+            nk::EventSystem::dispatch();
+        });
+        const nk::f64 channel_time = measure([&] {
+            for (nk::u32 i = 0; i < batch; i++) {
+                nk::EventChannel<ChannelTestBench>::post(ChannelTestBench{.value = i});
+            }
+            nk::EventSystem::dispatch();
+        });
+
+        std::printf("%6llu events/frame: post_event %6.2fns | EventChannel::post %6.2fns\n",
+                    static_cast<unsigned long long>(batch), event_time, channel_time);
+    }
+
+    nk::EventChannel<ChannelTestBench>::unregister_listener(channel);
+    nk::EventSystem::unregister_event(event);
+    nk::EventSystem::shutdown();
+    NK_MEMORY_SYSTEM_SHUTDOWN();
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include "systems/event_recorder.h"
+#include "systems/input_system.h"
+#include "systems/memory_system.h"
+
+static constexpr nk::SystemEventCode recorder_test_code = static_cast<nk::SystemEventCode>(0x44);
+static constexpr nk::KeyCodeFlag recorder_test_key = 0x41;
+static constexpr nk::KeyCodeFlag recorder_test_live_key = 0x42;
+
+struct RecorderTestEntry {
+    nk::u32 frame;
+    nk::SystemEventCode code;
+    nk::u32 value;
+
+    bool operator==(const RecorderTestEntry&) const = default;
+};
+
+static RecorderTestEntry recorder_test_log[16];
+static nk::u32 recorder_test_length;
+static nk::u32 recorder_test_frame;
+
+static bool on_recorded(nk::SystemEventCode code, void* sender, void* listener, nk::EventContext context) {
+    const nk::u32 value = code == recorder_test_code ? context.data.u32[0] : context.data.u16[0];
+    recorder_test_log[recorder_test_length++] = {recorder_test_frame, code, value};
+    return false;
+}
+
+static void recorder_test_frame_end() {
+    nk::EventSystem::dispatch();
+    recorder_test_frame++;
+}
+
+TEST(EventRecorder, EventRecorderRecordAndReplay) {
+    NK_MEMORY_SYSTEM_INIT();
+    nk::EventSystem::init();
+    nk::EventRecorder::init();
+
+    const nk::EventHandle handles[2] = {
+        nk::EventSystem::register_event(recorder_test_code, nullptr, on_recorded),
+        nk::EventSystem::register_event(nk::SystemEventCode::KeyPressed, nullptr, on_recorded),
+    };
+
+    const std::string path = (std::filesystem::temp_directory_path() / "nk_event_recorder_test.nkrec").string();
+    ASSERT_TRUE(nk::EventRecorder::start_recording(path.c_str()));
+
+    nk::EventContext context = {};
+    nk::EventRecorder::begin_capture();
+    context.data.u32[0] = 1;
+    nk::EventSystem::post_event(recorder_test_code, nullptr, context);
+    context.data.u32[0] = 2;
+    nk::EventSystem::post_event(recorder_test_code, nullptr, context);
+    nk::EventRecorder::end_capture();
+    recorder_test_frame_end();
+
+    nk::EventRecorder::begin_capture();
+    nk::InputSystem::process_key(recorder_test_key, true);
+    nk::EventRecorder::end_capture();
+    recorder_test_frame_end();
+
+    nk::EventRecorder::begin_capture();
+    nk::EventRecorder::end_capture();
+    recorder_test_frame_end();
+
+    nk::EventRecorder::begin_capture();
+    context.data.u32[0] = 3;
+    nk::EventSystem::post_event(recorder_test_code, nullptr, context);
+    nk::EventRecorder::end_capture();
+
+    // Posted outside the capture, by the frame itself, so not recorded.
+    context.data.u32[0] = 99;
+    nk::EventSystem::post_event(recorder_test_code, nullptr, context);
+    recorder_test_frame_end();
+
+    ASSERT_TRUE(nk::EventRecorder::stop_recording());
+    EXPECT_EQ(nk::EventRecorder::mode(), nk::EventRecorder::Mode::Idle);
+
+    const nk::u32 recorded_length = recorder_test_length;
+    RecorderTestEntry recorded[16];
+    std::copy(recorder_test_log, recorder_test_log + recorded_length, recorded);
+    ASSERT_EQ(recorded_length, 5);
+
+    nk::InputSystem::process_key(recorder_test_key, false);
+    nk::EventSystem::dispatch();
+    recorder_test_length = 0;
+    recorder_test_frame = 0;
+
+    ASSERT_TRUE(nk::EventRecorder::start_replay(path.c_str(), 0.5));
+    EXPECT_TRUE(nk::EventRecorder::replaying());
+    EXPECT_EQ(nk::EventRecorder::fixed_delta(), 0.5);
+
+    // Live input is dropped, the recorded frames come back as they were.
+    for (nk::u32 frame = 0; frame < 4; frame++) {
+        nk::EventRecorder::begin_capture();
+        context.data.u32[0] = 50;
+        EXPECT_FALSE(nk::EventSystem::post_event(recorder_test_code, nullptr, context));
+        nk::InputSystem::process_key(recorder_test_live_key, true);
+        nk::EventRecorder::end_capture();
+
+        if (frame == 3) {
+            context.data.u32[0] = 99;
+            nk::EventSystem::post_event(recorder_test_code, nullptr, context);
+        }
+        recorder_test_frame_end();
+    }
+
+    EXPECT_FALSE(nk::EventRecorder::replaying());
+    EXPECT_TRUE(nk::InputSystem::get().is_key_down(recorder_test_key));
+    EXPECT_FALSE(nk::InputSystem::get().is_key_down(recorder_test_live_key));
+
+    ASSERT_EQ(recorder_test_length, recorded_length);
+    for (nk::u32 i = 0; i < recorded_length; i++) {
+        EXPECT_EQ(recorder_test_log[i], recorded[i]);
+    }
+
+    nk::InputSystem::process_key(recorder_test_key, false);
+    nk::EventSystem::dispatch();
+    for (const nk::EventHandle& handle : handles) {
+        nk::EventSystem::unregister_event(handle);
+    }
+    nk::EventRecorder::shutdown();
+    nk::EventSystem::shutdown();
+    NK_MEMORY_SYSTEM_SHUTDOWN();
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,347 @@
+#include <gtest/gtest.h>
+
+#include "systems/event_system.h"
+#include "systems/memory_system.h"
+
+static constexpr nk::SystemEventCode event_test_first = static_cast<nk::SystemEventCode>(0x41);
+static constexpr nk::SystemEventCode event_test_second = static_cast<nk::SystemEventCode>(0x42);
+
+static nk::u32 event_test_log[nk::EventSystem::queue_capacity * 2];
+static nk::u64 event_test_log_length;
+
+static bool on_queued(nk::SystemEventCode code, void* sender, void* listener, nk::EventContext context) {
+    event_test_log[event_test_log_length++] = context.data.u32[0];
+
+    // Reposts from a listener land in the next dispatch.
+    if (context.data.u32[0] == 100) {
+        nk::EventContext repost = {};
+        repost.data.u32[0] = 101;
+        nk::EventSystem::post_event(code, sender, repost);
+    }
+    return false;
+}
+
+TEST(EventSystem, EventSystemPostAndDispatch) {
+    NK_MEMORY_SYSTEM_INIT();
+    nk::EventSystem::init();
+    const nk::EventHandle first = nk::EventSystem::register_event(event_test_first, nullptr, on_queued);
+    const nk::EventHandle second = nk::EventSystem::register_event(event_test_second, nullptr, on_queued);
+
+    nk::EventContext context = {};
+    const nk::SystemEventCode codes[] = {event_test_second, event_test_first, event_test_second, event_test_first};
+    for (nk::u32 i = 0; i < 4; i++) {
+        context.data.u32[0] = i;
+        nk::EventSystem::post_event(codes[i], nullptr, context);
+    }
+    context.data.u32[0] = 100;
+    nk::EventSystem::post_event(event_test_first, nullptr, context);
+
+    EXPECT_EQ(nk::EventSystem::queued_count(), 5);
+    EXPECT_EQ(event_test_log_length, 0);
+
+    nk::EventSystem::dispatch();
+    const nk::u32 grouped[] = {1, 3, 100, 0, 2};
+    ASSERT_EQ(event_test_log_length, 5);
+    for (nk::u32 i = 0; i < 5; i++) {
+        EXPECT_EQ(event_test_log[i], grouped[i]);
+    }
+    EXPECT_EQ(nk::EventSystem::queued_count(), 1);
+
+    nk::EventSystem::dispatch();
+    EXPECT_EQ(event_test_log_length, 6);
+    EXPECT_EQ(event_test_log[5], 101);
+
+    // Overflowing the queue dispatches early instead of dropping events.
+    event_test_log_length = 0;
+    for (nk::u32 i = 0; i < nk::EventSystem::queue_capacity + 1; i++) {
+        context.data.u32[0] = 1000 + i;
+        nk::EventSystem::post_event(event_test_first, nullptr, context);
+    }
+    EXPECT_EQ(event_test_log_length, nk::EventSystem::queue_capacity);
+    nk::EventSystem::dispatch();
+    EXPECT_EQ(event_test_log_length, nk::EventSystem::queue_capacity + 1);
+    EXPECT_EQ(event_test_log[nk::EventSystem::queue_capacity], 1000 + nk::EventSystem::queue_capacity);
+
+    nk::EventSystem::unregister_event(first);
+    nk::EventSystem::unregister_event(second);
+    nk::EventSystem::shutdown();
+    NK_MEMORY_SYSTEM_SHUTDOWN();
+}
+
+static std::atomic<nk::u32> event_test_thread_sum;
+
+static bool on_thread_posted(nk::SystemEventCode code, void* sender, void* listener, nk::EventContext context) {
+    event_test_thread_sum += context.data.u32[0];
+    return true;
+}
+
+TEST(EventSystem, EventSystemCrossThread) {
+    NK_MEMORY_SYSTEM_INIT();
+    nk::EventSystem::init();
+    const nk::EventHandle listener = nk::EventSystem::register_event(event_test_first, nullptr, on_thread_posted);
+
+    // Workers post into the inbox, listeners only run on dispatch.
+    std::thread workers[4];
+    for (nk::u32 t = 0; t < 4; t++) {
+        workers[t] = std::thread([] {
+            EXPECT_FALSE(nk::EventSystem::is_main_thread());
+            nk::EventContext context = {};
+            for (nk::u32 i = 1; i <= 200; i++) {
+                context.data.u32[0] = i;
+                EXPECT_TRUE(nk::EventSystem::post_event(event_test_first, nullptr, context));
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(event_test_thread_sum, 0);
+    nk::EventSystem::dispatch();
+    EXPECT_EQ(event_test_thread_sum, 4 * 200 * 201 / 2);
+
+    // A worker owned queue receives the events even though the listener consumes them.
+    nk::ThreadEventQueue queue;
+    EXPECT_TRUE(nk::EventSystem::register_queue(event_test_first, &queue));
+    EXPECT_FALSE(nk::EventSystem::register_queue(event_test_first, &queue));
+
+    nk::EventContext context = {};
+    for (nk::u32 i = 0; i < 10; i++) {
+        context.data.u32[0] = i;
+        nk::EventSystem::post_event(event_test_first, nullptr, context);
+    }
+    nk::EventSystem::dispatch();
+
+    nk::u32 received = 0;
+    std::thread consumer([&] {
+        nk::QueuedEvent event;
+        while (queue.mpsc_queue_pop(event)) {
+            EXPECT_EQ(event.context.data.u32[0], received);
+            received++;
+        }
+    });
+    consumer.join();
+    EXPECT_EQ(received, 10);
+
+    EXPECT_TRUE(nk::EventSystem::unregister_queue(event_test_first, &queue));
+    nk::EventSystem::unregister_event(listener);
+    nk::EventSystem::shutdown();
+    NK_MEMORY_SYSTEM_SHUTDOWN();
+}
+
+static nk::u32 event_test_order[8];
+static nk::u32 event_test_order_length;
+
+static bool on_ordered(nk::SystemEventCode code, void* sender, void* listener, nk::EventContext context) {
+    event_test_order[event_test_order_length++] = static_cast<nk::u32>(reinterpret_cast<nk::u64>(listener));
+    return static_cast<nk::u32>(reinterpret_cast<nk::u64>(listener)) == context.data.u32[0];
+}
+
+static bool on_ordered_again(nk::SystemEventCode code, void* sender, void* listener, nk::EventContext context) {
+    event_test_order[event_test_order_length++] = 10 + static_cast<nk::u32>(reinterpret_cast<nk::u64>(listener));
+    return false;
+}
+
+TEST(EventSystem, EventSystemHandlesAndPriorities) {
+    NK_MEMORY_SYSTEM_INIT();
+    nk::EventSystem::init();
+
+    nk::EventHandle handles[4];
+    handles[0] = nk::EventSystem::register_event(event_test_first, reinterpret_cast<void*>(1), on_ordered);
+    handles[1] = nk::EventSystem::register_event(event_test_first, reinterpret_cast<void*>(2), on_ordered, 5);
+    handles[2] = nk::EventSystem::register_event(event_test_first, reinterpret_cast<void*>(3), on_ordered);
+    // Same listener, second callback.
+    handles[3] = nk::EventSystem::register_event(event_test_first, reinterpret_cast<void*>(1), on_ordered_again, 5);
+
+    // Highest priority first, ties in registration order.
+    nk::EventContext context = {};
+    nk::EventSystem::fire_event(event_test_first, nullptr, context);
+    const nk::u32 expected[] = {2, 11, 1, 3};
+    ASSERT_EQ(event_test_order_length, 4);
+    for (nk::u32 i = 0; i < 4; i++) {
+        EXPECT_EQ(event_test_order[i], expected[i]);
+    }
+
+    // A consuming high priority listener stops the rest.
+    event_test_order_length = 0;
+    context.data.u32[0] = 2;
+    EXPECT_TRUE(nk::EventSystem::fire_event(event_test_first, nullptr, context));
+    EXPECT_EQ(event_test_order_length, 1);
+
+    // Removing from the middle keeps the order of the others.
+    EXPECT_TRUE(nk::EventSystem::unregister_event(handles[1]));
+    EXPECT_FALSE(nk::EventSystem::unregister_event(handles[1]));
+    EXPECT_FALSE(nk::EventSystem::is_registered(handles[1]));
+    EXPECT_FALSE(nk::EventSystem::unregister_event(nk::EventSystem::invalid_handle));
+
+    // The freed slot is reused with a new generation, the stale handle stays dead.
+    const nk::EventHandle reused = nk::EventSystem::register_event(event_test_first, reinterpret_cast<void*>(4), on_ordered, -1);
+    EXPECT_EQ(reused.index, handles[1].index);
+    EXPECT_FALSE(nk::EventSystem::is_registered(handles[1]));
+    EXPECT_TRUE(nk::EventSystem::is_registered(reused));
+
+    event_test_order_length = 0;
+    context.data.u32[0] = 0;
+    nk::EventSystem::post_event(event_test_first, nullptr, context);
+    nk::EventSystem::dispatch();
+    const nk::u32 after[] = {11, 1, 3, 4};
+    ASSERT_EQ(event_test_order_length, 4);
+    for (nk::u32 i = 0; i < 4; i++) {
+        EXPECT_EQ(event_test_order[i], after[i]);
+    }
+
+    nk::EventSystem::unregister_event(handles[0]);
+    nk::EventSystem::unregister_event(handles[2]);
+    nk::EventSystem::unregister_event(handles[3]);
+    nk::EventSystem::unregister_event(reused);
+    nk::EventSystem::shutdown();
+    NK_MEMORY_SYSTEM_SHUTDOWN();
+}
+
+static nk::EventContext event_test_coalesced[8];
+static nk::u32 event_test_coalesced_length;
+
+static bool on_coalesced(nk::SystemEventCode code, void* sender, void* listener, nk::EventContext context) {
+    event_test_coalesced[event_test_coalesced_length++] = context;
+    return false;
+}
+
+TEST(EventSystem, EventSystemCoalescing) {
+    NK_MEMORY_SYSTEM_INIT();
+    nk::EventSystem::init();
+
+    const nk::EventHandle handles[3] = {
+        nk::EventSystem::register_event(nk::SystemEventCode::Resized, nullptr, on_coalesced),
+        nk::EventSystem::register_event(nk::SystemEventCode::MouseWheel, nullptr, on_coalesced),
+        nk::EventSystem::register_event(event_test_first, nullptr, on_coalesced),
+    };
+
+    // A drag resize posts many sizes, only the last one is delivered.
+    nk::EventContext context = {};
+    for (nk::u32 i = 1; i <= 10; i++) {
+        context.data.u32[0] = i * 100;
+        context.data.u32[1] = i * 50;
+        nk::EventSystem::post_event(nk::SystemEventCode::Resized, nullptr, context);
+    }
+
+    // Wheel deltas add up and saturate.
+    context = {};
+    for (nk::u32 i = 0; i < 5; i++) {
+        context.data.i8[0] = -1;
+        nk::EventSystem::post_event(nk::SystemEventCode::MouseWheel, nullptr, context);
+    }
+
+    // Codes without a policy keep every event.
+    for (nk::u32 i = 0; i < 3; i++) {
+        context.data.u32[0] = i;
+        nk::EventSystem::post_event(event_test_first, nullptr, context);
+    }
+    EXPECT_EQ(nk::EventSystem::queued_count(), 5);
+
+    nk::EventSystem::dispatch();
+    ASSERT_EQ(event_test_coalesced_length, 5);
+    EXPECT_EQ(event_test_coalesced[0].data.i8[0], -5);
+    EXPECT_EQ(event_test_coalesced[1].data.u32[0], 1000);
+    EXPECT_EQ(event_test_coalesced[1].data.u32[1], 500);
+    EXPECT_EQ(event_test_coalesced[4].data.u32[0], 2);
+
+    // Coalescing starts over after a dispatch.
+    event_test_coalesced_length = 0;
+    context = {};
+    for (nk::u32 i = 0; i < 200; i++) {
+        context.data.i8[0] = 1;
+        nk::EventSystem::post_event(nk::SystemEventCode::MouseWheel, nullptr, context);
+    }
+    nk::EventSystem::set_coalescing(event_test_first, nk::EventSystem::coalesce_keep_last);
+    context.data.u32[0] = 7;
+    nk::EventSystem::post_event(event_test_first, nullptr, context);
+    context.data.u32[0] = 8;
+    nk::EventSystem::post_event(event_test_first, nullptr, context);
+
+    nk::EventSystem::dispatch();
+    ASSERT_EQ(event_test_coalesced_length, 2);
+    EXPECT_EQ(event_test_coalesced[0].data.i8[0], 127);
+    EXPECT_EQ(event_test_coalesced[1].data.u32[0], 8);
+
+    // A full queue still coalesces into the queued event instead of dispatching early.
+    event_test_coalesced_length = 0;
+    context = {};
+    context.data.u32[0] = 1;
+    nk::EventSystem::post_event(nk::SystemEventCode::Resized, nullptr, context);
+    for (nk::u32 i = 1; i < nk::EventSystem::queue_capacity; i++) {
+        nk::EventSystem::post_event(event_test_second, nullptr, context);
+    }
+    context.data.u32[0] = 2;
+    nk::EventSystem::post_event(nk::SystemEventCode::Resized, nullptr, context);
+    EXPECT_EQ(event_test_coalesced_length, 0);
+    EXPECT_EQ(nk::EventSystem::queued_count(), nk::EventSystem::queue_capacity);
+
+    nk::EventSystem::dispatch();
+    ASSERT_EQ(event_test_coalesced_length, 1);
+    EXPECT_EQ(event_test_coalesced[0].data.u32[0], 2);
+
+    for (const nk::EventHandle& handle : handles) {
+        nk::EventSystem::unregister_event(handle);
+    }
+    nk::EventSystem::shutdown();
+    NK_MEMORY_SYSTEM_SHUTDOWN();
+}
+
+#if NK_EVENT_STATS
+static bool on_stats_consume(nk::SystemEventCode code, void* sender, void* listener, nk::EventContext context) {
+    return context.data.u32[0] == 1;
+}
+
+static bool on_stats_pass(nk::SystemEventCode code, void* sender, void* listener, nk::EventContext context) {
+    return false;
+}
+
+TEST(EventSystem, EventSystemStats) {
+    NK_MEMORY_SYSTEM_INIT();
+    nk::EventSystem::init();
+
+    const nk::EventHandle consume = nk::EventSystem::register_event(event_test_first, nullptr, on_stats_consume, 1);
+    const nk::EventHandle pass = nk::EventSystem::register_event(event_test_first, nullptr, on_stats_pass);
+
+    // Nothing is counted until enabled.
+    nk::EventContext context = {};
+    nk::EventSystem::fire_event(event_test_first, nullptr, context);
+    EXPECT_FALSE(nk::EventSystem::stats_enabled());
+    EXPECT_EQ(nk::EventSystem::code_stats(event_test_first).event_count, 0);
+
+    nk::EventSystem::set_stats_enabled(true);
+    nk::EventSystem::fire_event(event_test_first, nullptr, context);
+    context.data.u32[0] = 1;
+    nk::EventSystem::post_event(event_test_first, nullptr, context);
+    nk::EventSystem::dispatch();
+    nk::EventSystem::fire_event(event_test_second, nullptr, context);
+
+    const nk::EventCodeStats stats = nk::EventSystem::code_stats(event_test_first);
+    EXPECT_EQ(stats.event_count, 2);
+    EXPECT_EQ(stats.listener_count, 2);
+    EXPECT_EQ(stats.callback_count, 3);
+    EXPECT_EQ(stats.consumed_count, 1);
+    EXPECT_EQ(stats.last_consumer.index, consume.index);
+    EXPECT_GE(stats.cycles, stats.max_cycles);
+
+    // A code without listeners still counts its events.
+    EXPECT_EQ(nk::EventSystem::code_stats(event_test_second).event_count, 1);
+    EXPECT_EQ(nk::EventSystem::code_stats(event_test_second).callback_count, 0);
+
+    const nk::EventListenerStats consumer = nk::EventSystem::listener_stats(consume);
+    EXPECT_EQ(consumer.callback_count, 2);
+    EXPECT_EQ(consumer.consumed_count, 1);
+    EXPECT_EQ(nk::EventSystem::listener_stats(pass).callback_count, 1);
+
+    nk::EventSystem::log_stats_summary();
+    nk::EventSystem::reset_stats();
+    EXPECT_EQ(nk::EventSystem::code_stats(event_test_first).event_count, 0);
+    EXPECT_EQ(nk::EventSystem::listener_stats(consume).callback_count, 0);
+
+    nk::EventSystem::set_stats_enabled(false);
+    nk::EventSystem::unregister_event(consume);
+    nk::EventSystem::unregister_event(pass);
+    nk::EventSystem::shutdown();
+    NK_MEMORY_SYSTEM_SHUTDOWN();
+}
+#endif
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include "core/hash.h"
+#include "systems/event_system.h"
+#include "systems/input_system.h"
+#include "systems/memory_system.h"
+
+static void input_test_frame() {
+    nk::EventSystem::dispatch();
+    nk::InputSystem::evaluate_actions();
+}
+
+TEST(InputSystem, InputSystemActions) {
+    NK_MEMORY_SYSTEM_INIT();
+    nk::EventSystem::init();
+    nk::InputSystem& input = nk::InputSystem::get();
+
+    const nk::InputAction jump = nk::InputSystem::bind_action(nk::hash::string("Jump"), {nk::KeyCode::Space});
+    const nk::InputAction save = nk::InputSystem::bind_action(nk::hash::string("Save"), {nk::KeyCode::Ctrl, nk::KeyCode::S});
+    // A second chord for the same action.
+    EXPECT_EQ(nk::InputSystem::bind_action(nk::hash::string("Jump"), {nk::KeyCode::W}).index, jump.index);
+    EXPECT_EQ(nk::InputSystem::find_action(nk::hash::string("Save")).index, save.index);
+    EXPECT_EQ(nk::InputSystem::find_action(nk::hash::string("Crouch")).index, nk::InputSystem::invalid_action.index);
+    EXPECT_EQ(nk::InputSystem::bind_action(nk::hash::string("Empty"), {}).index, nk::InputSystem::invalid_action.index);
+
+    nk::InputSystem::process_key(nk::KeyCode::Space, true);
+    nk::InputSystem::process_key(nk::KeyCode::S, true);
+    input_test_frame();
+    EXPECT_TRUE(input.is_action_down(jump));
+    EXPECT_TRUE(input.is_action_pressed(jump));
+    EXPECT_FALSE(input.is_action_down(save));
+    EXPECT_TRUE(input.is_key_pressed(nk::KeyCode::Space));
+    EXPECT_FALSE(input.is_action_down(nk::InputSystem::invalid_action));
+    nk::InputSystem::update(0.0);
+
+    // Held, no edge. The chord completes once Ctrl joins S.
+    nk::InputSystem::process_key(nk::KeyCode::Ctrl, true);
+    input_test_frame();
+    EXPECT_TRUE(input.is_action_down(jump));
+    EXPECT_FALSE(input.is_action_pressed(jump));
+    EXPECT_FALSE(input.is_key_pressed(nk::KeyCode::Space));
+    EXPECT_TRUE(input.is_action_pressed(save));
+    nk::InputSystem::update(0.0);
+
+    // Releasing Space keeps Jump down through its W chord.
+    nk::InputSystem::process_key(nk::KeyCode::W, true);
+    nk::InputSystem::process_key(nk::KeyCode::Space, false);
+    nk::InputSystem::process_key(nk::KeyCode::S, false);
+    input_test_frame();
+    EXPECT_TRUE(input.is_action_down(jump));
+    EXPECT_FALSE(input.is_action_released(jump));
+    EXPECT_TRUE(input.is_action_released(save));
+    EXPECT_TRUE(input.is_key_released(nk::KeyCode::Space));
+    EXPECT_TRUE(input.is_key_released(nk::KeyCode::S));
+    nk::InputSystem::update(0.0);
+
+    nk::InputSystem::process_key(nk::KeyCode::W, false);
+    nk::InputSystem::process_key(nk::KeyCode::Ctrl, false);
+    input_test_frame();
+    EXPECT_TRUE(input.is_action_released(jump));
+    EXPECT_FALSE(input.is_action_down(jump));
+    nk::InputSystem::update(0.0);
+
+    nk::InputSystem::clear_actions();
+    EXPECT_EQ(nk::InputSystem::find_action(nk::hash::string("Jump")).index, nk::InputSystem::invalid_action.index);
+
+    nk::EventSystem::shutdown();
+    NK_MEMORY_SYSTEM_SHUTDOWN();
+}
+
+static std::atomic<nk::u32> input_test_sample_calls;
+
+static void input_test_sample(void* user_data) {
+    const nk::u32 call = input_test_sample_calls.fetch_add(1) + 1;
+    nk::InputSystem::push_sample({
+        .timestamp_ns = nk::InputSystem::timestamp_ns(),
+        .kind = nk::InputSystem::InputSample::Kind::MouseMove,
+        .x = static_cast<nk::i16>(call),
+        .y = *static_cast<nk::i16*>(user_data),
+    });
+}
+
+TEST(InputSystem, InputSystemSamples) {
+    NK_MEMORY_SYSTEM_INIT();
+    nk::EventSystem::init();
+    nk::InputSystem& input = nk::InputSystem::get();
+    input.reset_queue_latency_stats();
+
+    // Earlier tests share the instance, start away from the sampled
+    // positions with an empty history.
+    nk::InputSystem::process_mouse_move(0, 0);
+    input.reset_motion_history();
+
+    // Pushed from another thread, applied in order by the main thread.
+    std::thread producer([] {
+        for (nk::i16 i = 1; i <= 4; i++) {
+            nk::InputSystem::push_sample({
+                .timestamp_ns = 1000u * i,
+                .kind = nk::InputSystem::InputSample::Kind::MouseMove,
+                .x = static_cast<nk::i16>(10 * i),
+                .y = static_cast<nk::i16>(-5 * i),
+            });
+        }
+        nk::InputSystem::push_sample({
+            .timestamp_ns = 5000,
+            .kind = nk::InputSystem::InputSample::Kind::MouseButton,
+            .pressed = true,
+            .button = nk::MouseButton::Right,
+        });
+    });
+    producer.join();
+
+    nk::InputSystem::consume_samples();
+    input_test_frame();
+
+    nk::i16 x, y;
+    input.get_mouse_position(x, y);
+    EXPECT_EQ(x, 40);
+    EXPECT_EQ(y, -20);
+    EXPECT_TRUE(input.is_mouse_button_down(nk::MouseButton::Right));
+
+    nk::InputSystem::MotionSample history[8];
+    ASSERT_EQ(input.motion_history(history, 8), 4);
+    EXPECT_EQ(history[0].timestamp_ns, 1000);
+    EXPECT_EQ(history[0].x, 10);
+    EXPECT_EQ(history[3].timestamp_ns, 4000);
+    EXPECT_EQ(input.motion_history(history, 2), 2);
+    EXPECT_EQ(history[1].x, 40);
+
+    // 10 px and -5 px per 1000 ns.
+    EXPECT_TRUE(input.predict_mouse_position(6000, x, y));
+    EXPECT_EQ(x, 60);
+    EXPECT_EQ(y, -30);
+    EXPECT_FALSE(input.predict_mouse_position(4000, x, y));
+    EXPECT_EQ(x, 40);
+
+    const nk::InputSystem::QueueLatencyStats latency = input.queue_latency_stats();
+    EXPECT_EQ(latency.sample_count, 5);
+    EXPECT_GE(latency.max_ns, latency.total_ns / latency.sample_count);
+
+    // The sampling thread runs the callback until stopped.
+    nk::i16 sampled_y = 7;
+    ASSERT_TRUE(nk::InputSystem::start_sampling(input_test_sample, &sampled_y, 1000));
+    EXPECT_TRUE(nk::InputSystem::sampling());
+    EXPECT_FALSE(nk::InputSystem::start_sampling(input_test_sample, &sampled_y, 1000));
+    while (input_test_sample_calls.load() < 3) {
+        std::this_thread::yield();
+    }
+    nk::InputSystem::stop_sampling();
+    EXPECT_FALSE(nk::InputSystem::sampling());
+
+    nk::InputSystem::consume_samples();
+    input.get_mouse_position(x, y);
+    EXPECT_EQ(x, static_cast<nk::i16>(input_test_sample_calls.load()));
+    EXPECT_EQ(y, 7);
+
+    nk::InputSystem::process_mouse_button(nk::MouseButton::Right, false);
+    input_test_frame();
+    nk::InputSystem::update(0.0);
+    nk::EventSystem::shutdown();
+    NK_MEMORY_SYSTEM_SHUTDOWN();
+}
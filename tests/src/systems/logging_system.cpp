@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 
 #include "systems/logging_system.h"
+#include "systems/binary_log.h"
+#include "systems/log_compression.h"
+#include "systems/flight_recorder.h"
+#include "platform/file.h"
+#include "systems/memory_system.h"
 
 TEST(LoggingSystem, LoggingSystemInit) {
     nk::LoggingSystem::init();
@@ -13,3 +18,401 @@ TEST(LoggingSystem, LoggingSystemInit) {
     nk::LoggingSystem::log(nk::LoggingLevel::None, __FILE__, 6, "MESSAGE");
     nk::LoggingSystem::shutdown();
 }
+
+TEST(LoggingSystem, LoggingSystemAsync) {
+    nk::LoggingSystemConfig config = nk::LoggingSystem::get_default_config();
+    config.show_time = false;
+    config.show_file = false;
+    config.async = true;
+
+    constexpr nk::u32 threads = 4;
+    constexpr nk::u32 lines = 200;
+
+    testing::internal::CaptureStdout();
+    nk::LoggingSystem::init(config);
+
+    std::thread loggers[threads];
+    for (nk::u32 t = 0; t < threads; t++) {
+        loggers[t] = std::thread([t] {
+            for (nk::u32 i = 0; i < lines; i++) {
+                InfoLog("[{}:{}]", t, i);
+            }
+        });
+    }
+    for (std::thread& logger : loggers) {
+        logger.join();
+    }
+
+    // Nothing is left in the rings after a flush.
+    nk::LoggingSystem::flush();
+    const std::string flushed = testing::internal::GetCapturedStdout();
+    nk::LoggingSystem::shutdown();
+
+    EXPECT_EQ(nk::LoggingSystem::dropped_count(), 0);
+
+    // Every line once, in order within its thread.
+    for (nk::u32 t = 0; t < threads; t++) {
+        std::size_t position = 0;
+        for (nk::u32 i = 0; i < lines; i++) {
+            position = flushed.find(std::format("[{}:{}]", t, i), position);
+            ASSERT_NE(position, std::string::npos);
+        }
+    }
+}
+
+TEST(LoggingSystem, LoggingSystemBinary) {
+    NK_MEMORY_SYSTEM_INIT();
+
+    nk::LoggingSystemConfig config = nk::LoggingSystem::get_default_config();
+    config.show_time = false;
+    config.show_file = false;
+    config.async = true;
+
+    // Decoded by the writer thread.
+    testing::internal::CaptureStdout();
+    nk::LoggingSystem::init(config);
+    InfoLog("{} + {} = {:.1f}, {} {}", 1, 2u, 3.0, true, std::string_view("done"));
+    nk::LoggingSystem::flush();
+    const std::string console = testing::internal::GetCapturedStdout();
+    EXPECT_NE(console.find("1 + 2 = 3.0, true done"), std::string::npos);
+
+    // Written as is and decoded offline.
+    const std::string path = (std::filesystem::temp_directory_path() / "nk_logging_binary_test.nklog").string();
+    config.binary_output = path.c_str();
+    nk::LoggingSystem::init(config);
+
+    const char name[8] = "binary";
+    for (nk::i32 i = 0; i < 3; i++) {
+        InfoLog("{} line {:>3} {:x} '{}'", name, -i, 255u, 'c');
+    }
+    InfoLog("Floats {} {} {}", 0.1f, 0.1, 0.1L);
+    InfoLog("Width [{:>{}}] [{:.{}f}]", name, 8, 3.14159, 2);
+    InfoLog("Escapes {{{}}}", 5);
+    DebugLog("No arguments {keeps} its braces");
+    WarnLog("Text line {}", 7);
+    nk::LoggingSystem::shutdown();
+
+    std::string text;
+    ASSERT_TRUE(nk::binary_log::decode_file(path.c_str(), text));
+    EXPECT_NE(text.find(" [Info]: binary line   0 ff 'c'"), std::string::npos);
+    EXPECT_NE(text.find("binary line  -2 ff 'c'"), std::string::npos);
+    EXPECT_NE(text.find(std::format(" [Info]: Floats {} {} {}", 0.1f, 0.1, 0.1L)), std::string::npos);
+    EXPECT_NE(text.find(" [Info]: Width [  binary] [3.14]"), std::string::npos);
+    EXPECT_NE(text.find(" [Info]: Escapes {5}"), std::string::npos);
+    EXPECT_NE(text.find(" [Debug]: No arguments {keeps} its braces"), std::string::npos);
+    EXPECT_NE(text.find(" [Warning]: Text line 7"), std::string::npos);
+    EXPECT_NE(text.find("logging_system.cpp:"), std::string::npos);
+
+    std::filesystem::remove(path);
+    NK_MEMORY_SYSTEM_SHUTDOWN();
+}
+
+TEST(LoggingSystem, LoggingSystemBinaryCorrupt) {
+    // A string argument, its tag, u32 size and bytes.
+    const std::string_view name = "corrupt";
+    const nk::u32 length = static_cast<nk::u32>(name.size());
+    nk::u8 arguments[32] = {static_cast<nk::u8>(nk::LogArgument::String)};
+    std::memcpy(arguments + 1, &length, sizeof(length));
+    std::memcpy(arguments + 1 + sizeof(length), name.data(), name.size());
+    const nk::u64 size = 1 + sizeof(length) + name.size();
+
+    std::string message;
+    EXPECT_TRUE(nk::binary_log::format_arguments("{}", arguments, size, message));
+    EXPECT_EQ(message, "corrupt");
+
+    // Cut inside the string, inside its length and after an unknown tag.
+    for (nk::u64 cut : {size - 1, nk::u64{3}}) {
+        message.clear();
+        EXPECT_FALSE(nk::binary_log::format_arguments("{}", arguments, cut, message));
+        EXPECT_EQ(message, nk::binary_log::corrupt_record);
+    }
+
+    arguments[0] = 0xFF;
+    message.clear();
+    EXPECT_FALSE(nk::binary_log::format_arguments("{}", arguments, size, message));
+    EXPECT_EQ(message, nk::binary_log::corrupt_record);
+}
+
+TEST(LoggingSystem, LoggingSystemPriority) {
+    nk::LoggingSystemConfig config = nk::LoggingSystem::get_default_config();
+    config.show_time = false;
+    config.priority = nk::LoggingLevel::Warning;
+    config.async = false;
+
+    nk::u32 evaluated = 0;
+    auto count = [&evaluated]() { return ++evaluated; };
+
+    testing::internal::CaptureStdout();
+    nk::LoggingSystem::init(config);
+    InfoLog("Info {}", count());
+    DebugLog("Debug {}", count());
+    WarnLog("Warning {}", count());
+    ErrorLog("Error {}", count());
+
+    nk::LoggingSystem::set_priority(nk::LoggingLevel::Error);
+    WarnLog("Hidden {}", count());
+    nk::LoggingSystem::flush();
+    const std::string output = testing::internal::GetCapturedStdout();
+    nk::LoggingSystem::set_priority(nk::LoggingLevel::Trace);
+    nk::LoggingSystem::shutdown();
+
+    // Filtered lines never evaluate their arguments.
+    EXPECT_EQ(evaluated, 2);
+    EXPECT_EQ(output.find("Info"), std::string::npos);
+    EXPECT_EQ(output.find("Hidden"), std::string::npos);
+    EXPECT_NE(output.find(" [Warning]: Warning 1"), std::string::npos);
+    EXPECT_NE(output.find(" [Error]: Error 2"), std::string::npos);
+
+#ifdef NK_PROJECT_PATH
+    static_assert(nk::log_file(__FILE__) == "tests/src/systems/logging_system.cpp");
+    EXPECT_NE(output.find("(tests/src/systems/logging_system.cpp:"), std::string::npos);
+#endif
+}
+
+class CaptureSink final : public nk::LogSink {
+public:
+    void write(std::string_view lines) override { text.append(lines); }
+    void flush() override { flushes++; }
+
+    std::string text;
+    nk::u32 flushes = 0;
+};
+
+TEST(LoggingSystem, LoggingSystemFileSink) {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "nk_logging_file_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const std::string path = (directory / "test.log").string();
+
+    nk::LoggingSystemConfig config = nk::LoggingSystem::get_default_config();
+    config.show_time = false;
+    config.file_path = path.c_str();
+    config.file_max_size = nk::KiB(4);
+    config.file_max_backups = 2;
+    config.file_compress = true;
+    // Every line reaches the sinks on its own, the file rotates every 4 KiB.
+    config.async = false;
+
+    CaptureSink capture;
+    testing::internal::CaptureStdout();
+    nk::LoggingSystem::init(config);
+    ASSERT_TRUE(nk::LoggingSystem::add_sink(&capture));
+
+    constexpr nk::u32 lines = 500;
+    for (nk::u32 i = 0; i < lines; i++) {
+        InfoLog("File line {:03}", i);
+    }
+    ErrorLog("Flushed error");
+    nk::LoggingSystem::flush();
+    EXPECT_GT(capture.flushes, 0);
+    nk::LoggingSystem::shutdown();
+    testing::internal::GetCapturedStdout();
+
+    // The added sink ran next to the console and the file, without colors.
+    EXPECT_NE(capture.text.find(" [Info]: File line 000"), std::string::npos);
+    EXPECT_NE(capture.text.find(" [Error]: Flushed error"), std::string::npos);
+    EXPECT_EQ(capture.text.find('\033'), std::string::npos);
+
+    nk::u32 compressed = 0;
+    std::string rotated_text;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        const std::string name = entry.path().string();
+        if (name.ends_with(nk::log_compression::file_extension)) {
+            compressed++;
+            ASSERT_TRUE(nk::log_compression::decompress_file(name.c_str(), rotated_text));
+        } else {
+            EXPECT_EQ(name, path);
+        }
+    }
+
+    // Older rotations are gone, the kept ones decompress to plain lines.
+    EXPECT_EQ(compressed, config.file_max_backups);
+    EXPECT_NE(rotated_text.find(" [Info]: File line "), std::string::npos);
+    EXPECT_EQ(rotated_text.find('\033'), std::string::npos);
+
+    nk::File file;
+    ASSERT_TRUE(file.open(path.c_str(), nk::FileMode::Read, false));
+    std::string current;
+    nk::str line;
+    while (file.read_line(&line)) {
+        current += line;
+    }
+    file.close();
+    EXPECT_NE(current.find(" [Error]: Flushed error"), std::string::npos);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(LoggingSystem, LoggingSystemCompression) {
+    std::string input;
+    for (nk::u32 i = 0; i < 1000; i++) {
+        input += std::format("12:00:{:02} [Info]: Frame {} took {:.2f} ms (engine/src/core/engine.cpp:120)\n", i % 60, i, i * 0.37);
+    }
+
+    std::string compressed;
+    nk::log_compression::compress(reinterpret_cast<const nk::u8*>(input.data()), input.size(), compressed);
+    EXPECT_LT(compressed.size(), input.size() / 4);
+
+    std::string output;
+    ASSERT_TRUE(nk::log_compression::decompress(reinterpret_cast<const nk::u8*>(compressed.data()), compressed.size(), output));
+    EXPECT_EQ(output, input);
+
+    // A cut stream is reported instead of read past its end.
+    output.clear();
+    EXPECT_FALSE(nk::log_compression::decompress(reinterpret_cast<const nk::u8*>(compressed.data()), compressed.size() / 2, output));
+}
+
+TEST(LoggingSystem, LoggingSystemFlightRecorder) {
+    NK_MEMORY_SYSTEM_INIT();
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "nk_logging_recorder_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const std::string path = (directory / "flight.nkfr").string();
+
+    nk::LoggingSystemConfig config = nk::LoggingSystem::get_default_config();
+    config.show_time = false;
+    config.file_output = false;
+    config.priority = nk::LoggingLevel::Warning;
+    config.flight_recorder = path.c_str();
+    config.flight_recorder_size = nk::KiB(64);
+
+    testing::internal::CaptureStdout();
+    nk::LoggingSystem::init(config);
+
+    // More than the ring holds, the oldest lines get overwritten.
+    constexpr nk::u32 lines = 3000;
+    for (nk::u32 i = 0; i < lines; i++) {
+        InfoLog("Recorded {} of {}", i, lines);
+        if (i % 100 == 0) {
+            nk::LoggingSystem::flush();
+        }
+    }
+    WarnLog("Last warning");
+    nk::LoggingSystem::flush();
+
+    // Read while still mapped, as it would be after a crash.
+    std::string text;
+    ASSERT_TRUE(nk::FlightRecorder::decode_file(path.c_str(), text));
+
+    nk::LoggingSystem::shutdown();
+    const std::string console = testing::internal::GetCapturedStdout();
+
+    // Info lines were below the console priority, only the recorder kept them.
+    EXPECT_EQ(nk::LoggingSystem::dropped_count(), 0);
+    EXPECT_EQ(console.find("Recorded"), std::string::npos);
+    EXPECT_NE(console.find("Last warning"), std::string::npos);
+
+    EXPECT_EQ(text.find("Recorded 0 of"), std::string::npos);
+    const std::size_t before = text.find(std::format("Recorded {} of", lines - 2));
+    const std::size_t last = text.find(std::format("Recorded {} of", lines - 1));
+    ASSERT_NE(before, std::string::npos);
+    ASSERT_NE(last, std::string::npos);
+    EXPECT_LT(before, last);
+    const std::size_t warning = text.find(" [Warning]: Last warning");
+    ASSERT_NE(warning, std::string::npos);
+    EXPECT_GT(warning, last);
+
+    // The next run keeps the file of this one next to its own.
+    nk::LoggingSystem::init(config);
+    nk::LoggingSystem::shutdown();
+    std::string previous;
+    EXPECT_TRUE(nk::FlightRecorder::decode_file((directory / "flight.previous.nkfr").string().c_str(), previous));
+    EXPECT_NE(previous.find(std::format("Recorded {} of", lines - 1)), std::string::npos);
+
+    std::filesystem::remove_all(directory);
+    NK_MEMORY_SYSTEM_SHUTDOWN();
+}
+
+TEST(LoggingSystem, LoggingSystemRateLimit) {
+    nk::LoggingSystemConfig config = nk::LoggingSystem::get_default_config();
+    config.show_time = false;
+    config.file_output = false;
+    config.async = false;
+    // No token comes back while the flood runs, however slow the machine.
+    config.rate_limit_per_second = 1;
+    config.rate_limit_burst = 3;
+
+    // One call site for every line.
+    auto flood = [](nk::u32 i) { WarnLogLimited("Flood {}", i); };
+
+    testing::internal::CaptureStdout();
+    nk::LoggingSystem::init(config);
+
+    for (nk::u32 i = 0; i < 100; i++) {
+        flood(i);
+    }
+
+    // Plain call sites are never limited.
+    for (nk::u32 i = 0; i < 10; i++) {
+        WarnLog("Plain {}", i);
+    }
+
+    for (nk::u32 i = 0; i < 10; i++) {
+        InfoLogOnce("Once {}", i);
+        InfoLogEvery(4, "Every {}", i);
+        InfoLogEvery(0, "Never {}", i);
+    }
+
+    nk::LoggingSystem::flush();
+    std::string output = testing::internal::GetCapturedStdout();
+    nk::LoggingSystem::shutdown();
+
+    EXPECT_NE(output.find("Flood 0"), std::string::npos);
+    EXPECT_NE(output.find("Flood 2"), std::string::npos);
+    EXPECT_EQ(output.find("Flood 3"), std::string::npos);
+    EXPECT_EQ(output.find("Flood 99"), std::string::npos);
+    EXPECT_NE(output.find("Plain 9"), std::string::npos);
+
+    EXPECT_NE(output.find("Once 0"), std::string::npos);
+    EXPECT_EQ(output.find("Once 1"), std::string::npos);
+    EXPECT_NE(output.find("Every 0"), std::string::npos);
+    EXPECT_EQ(output.find("Every 1"), std::string::npos);
+    EXPECT_NE(output.find("Every 4"), std::string::npos);
+    EXPECT_NE(output.find("Every 8"), std::string::npos);
+    EXPECT_EQ(output.find("Never"), std::string::npos);
+
+    // A token comes back every 50 ms, the next line reports the suppressed ones.
+    config.rate_limit_per_second = 20;
+    config.rate_limit_burst = 1;
+
+    auto refill = [](nk::u32 i) { ErrorLogLimited("Refill {}", i); };
+
+    testing::internal::CaptureStdout();
+    nk::LoggingSystem::init(config);
+
+    for (nk::u32 i = 0; i < 10; i++) {
+        refill(i);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    refill(10);
+
+    nk::LoggingSystem::flush();
+    output = testing::internal::GetCapturedStdout();
+    nk::LoggingSystem::shutdown();
+
+    EXPECT_NE(output.find("Refill 0"), std::string::npos);
+    EXPECT_NE(output.find(" lines of this call site were suppressed."), std::string::npos);
+    EXPECT_NE(output.find("Refill 10"), std::string::npos);
+}
+
+TEST(LoggingSystem, DISABLED_LoggingSystemBenchmark) {
+    nk::LoggingSystemConfig config = nk::LoggingSystem::get_default_config();
+
+    for (bool async : {false, true}) {
+        config.async = async;
+        nk::LoggingSystem::init(config);
+
+        constexpr nk::u64 count = 100'000;
+        const auto start = std::chrono::steady_clock::now();
+        for (nk::u64 i = 0; i < count; i++) {
+            InfoLog("Benchmark line {} of {}", i, count);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        nk::LoggingSystem::shutdown();
+
+        const nk::f64 line_time = std::chrono::duration<nk::f64, std::nano>(end - start).count() / count;
+        std::printf("%s: %.1f ns per line on the caller, %llu dropped\n", async ? "async" : "sync", line_time,
+                    static_cast<unsigned long long>(nk::LoggingSystem::dropped_count()));
+    }
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include "systems/memory_system.h"
+#include "systems/timer_system.h"
+
+static constexpr nk::SystemEventCode timer_test_code = static_cast<nk::SystemEventCode>(0x40);
+
+static nk::u32 timer_test_fired[4];
+
+static bool on_timer(nk::SystemEventCode code, void* sender, void* listener, nk::EventContext context) {
+    timer_test_fired[context.data.u32[0]]++;
+    return false;
+}
+
+TEST(TimerSystem, TimerSystemFireAndCancel) {
+    NK_MEMORY_SYSTEM_INIT();
+    nk::EventSystem::init();
+    nk::TimerSystem::init();
+    const nk::EventHandle listener = nk::EventSystem::register_event(timer_test_code, nullptr, on_timer);
+
+    nk::EventContext context = {};
+    context.data.u32[0] = 0;
+    nk::TimerSystem::schedule(0.010, timer_test_code, context);
+    context.data.u32[0] = 1;
+    nk::TimerSystem::schedule(1.0, timer_test_code, context, 1.0);
+    context.data.u32[0] = 2;
+    auto cancelled = nk::TimerSystem::schedule(0.5, timer_test_code, context);
+    context.data.u32[0] = 3;
+    nk::TimerSystem::schedule(300.0, timer_test_code, context);
+
+    EXPECT_EQ(nk::TimerSystem::active_count(), 4);
+    EXPECT_TRUE(nk::TimerSystem::cancel(cancelled));
+    EXPECT_FALSE(nk::TimerSystem::cancel(cancelled));
+
+    nk::TimerSystem::update(0.005);
+    EXPECT_EQ(timer_test_fired[0], 0);
+    nk::TimerSystem::update(0.006);
+    EXPECT_EQ(timer_test_fired[0], 1);
+
+    for (nk::u32 frame = 0; frame < 60 * 10; frame++) {
+        nk::TimerSystem::update(1.0 / 60.0);
+    }
+    EXPECT_EQ(timer_test_fired[1], 10);
+    EXPECT_EQ(timer_test_fired[2], 0);
+    EXPECT_EQ(timer_test_fired[3], 0);
+
+    nk::TimerSystem::update(295.0);
+    EXPECT_EQ(timer_test_fired[3], 1);
+    EXPECT_EQ(nk::TimerSystem::active_count(), 1);
+
+    nk::EventSystem::unregister_event(listener);
+    nk::TimerSystem::shutdown();
+    nk::EventSystem::shutdown();
+    NK_MEMORY_SYSTEM_SHUTDOWN();
+}
+
+TEST(TimerSystem, TimerSystemNeverEarly) {
+    NK_MEMORY_SYSTEM_INIT();
+    nk::EventSystem::init();
+    nk::TimerSystem::init();
+    const nk::EventHandle listener = nk::EventSystem::register_event(timer_test_code, nullptr, on_timer);
+
+    // Scheduled half way through tick 10, the delay is up at 12.5 ms.
+    nk::TimerSystem::update(0.0105);
+    timer_test_fired[0] = 0;
+    nk::EventContext context = {};
+    context.data.u32[0] = 0;
+    nk::TimerSystem::schedule(0.002, timer_test_code, context);
+
+    // Tick 12 is reached before the delay is up.
+    nk::TimerSystem::update(0.0019);
+    EXPECT_EQ(timer_test_fired[0], 0);
+    nk::TimerSystem::update(0.0011);
+    EXPECT_EQ(timer_test_fired[0], 1);
+    EXPECT_EQ(nk::TimerSystem::active_count(), 0);
+
+    nk::EventSystem::unregister_event(listener);
+    nk::TimerSystem::shutdown();
+    nk::EventSystem::shutdown();
+    NK_MEMORY_SYSTEM_SHUTDOWN();
+}
@@ -0,0 +1,67 @@
+#include "systems/binary_log.h"
+#include "systems/log_compression.h"
+#include "systems/flight_recorder.h"
+#include "systems/memory_system.h"
+#include "platform/file.h"
+
+// log_decoder <binary log | compressed log | flight recorder> [text output]
+// Turns a log written with LoggingSystemConfig::binary_output, a rotated log
+// compressed by the file output or a flight recorder into text. To the
+// output file when given, stdout otherwise.
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: %s <binary log | compressed log | flight recorder> [text output]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    NK_MEMORY_SYSTEM_INIT();
+
+    bool succeeded;
+    {
+        nk::LoggingSystemConfig config = nk::LoggingSystem::get_default_config();
+        config.async = false;
+        config.file_output = false;
+        nk::LoggingSystem::init(config);
+
+        // The first bytes tell which kind of log it is.
+        nk::u32 magic = 0;
+        {
+            nk::File input;
+            nk::u64 read;
+            if (input.open(argv[1], nk::FileMode::Read, true)) {
+                input.read(sizeof(magic), &magic, &read);
+            }
+        }
+
+        std::string text;
+        switch (magic) {
+            case nk::log_compression::file_magic:
+                succeeded = nk::log_compression::decompress_file(argv[1], text);
+                break;
+            case nk::FlightRecorder::file_magic:
+                succeeded = nk::FlightRecorder::decode_file(argv[1], text);
+                break;
+            default:
+                succeeded = nk::binary_log::decode_file(argv[1], text);
+                break;
+        }
+        if (!succeeded) {
+            ErrorLog("log_decoder Could not decode all of {}, the output stops where it failed.", argv[1]);
+        }
+
+        if (argc > 2) {
+            nk::File output;
+            nk::u64 written;
+            succeeded = output.open(argv[2], nk::FileMode::Write, true) && output.write(text.size(), text.data(), &written) && succeeded;
+        } else {
+            nk::os::write(text.data(), text.size());
+            nk::os::flush();
+        }
+
+        nk::LoggingSystem::shutdown();
+    }
+
+    NK_MEMORY_SYSTEM_SHUTDOWN();
+
+    return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}